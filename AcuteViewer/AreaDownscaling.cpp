@@ -0,0 +1,383 @@
+#include "AreaDownscaling.h"
+
+//OpenCV
+#include <opencv2/imgproc.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//where the loader can pick a variant at startup, the row functions are additionally compiled for AVX2;
+//otherwise they are vectorised for the baseline instruction set of the target, e.g. SSE2 on x86-64 or NEON on ARM64
+#if defined(__x86_64__) && defined(__linux__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define SV_ROW_FUNCTION __attribute__((target_clones("avx2", "default")))
+#endif
+#endif
+#ifndef SV_ROW_FUNCTION
+#define SV_ROW_FUNCTION
+#endif
+
+namespace sv {
+
+	namespace downscaling {
+
+		namespace {
+
+			//below this number of source values the cost of waking up the OpenMP team outweighs the gain
+			constexpr long long minimumParallelValues = 1 << 20;
+
+			//the scaling factor ranges the choice is made for: 1/2 to 1, 1/4 to 1/2, 1/8 to 1/4 and below, each for integer and other factors
+			constexpr int factorRangeCount = 4;
+			std::atomic<bool> calibrated{ false };
+			std::atomic<bool> useOwnKernel[factorRangeCount][2];
+
+			///Which source pixels a destination pixel along one axis covers, and with which weight.
+			struct AxisWeights {
+				std::vector<int> first;
+				std::vector<int> count;
+				//index of the weight of the first source pixel in weights
+				std::vector<int> offset;
+				std::vector<float> weights;
+			};
+
+			AxisWeights axisWeights(int sourceLength, int destinationLength) {
+				AxisWeights result;
+				result.first.reserve(destinationLength);
+				result.count.reserve(destinationLength);
+				result.offset.reserve(destinationLength);
+				double scale = double(sourceLength) / destinationLength;
+				for (int i = 0; i < destinationLength; ++i) {
+					double begin = i * scale;
+					double end = std::min((i + 1) * scale, double(sourceLength));
+					int first = std::min(int(begin), sourceLength - 1);
+					int last = std::max(first + 1, std::min(int(std::ceil(end)), sourceLength));
+					result.first.push_back(first);
+					result.count.push_back(last - first);
+					result.offset.push_back(int(result.weights.size()));
+					for (int j = first; j < last; ++j) {
+						double overlap = std::min(end, j + 1.0) - std::max(begin, double(j));
+						result.weights.push_back(float(std::max(overlap, 0.0) / scale));
+					}
+				}
+				return result;
+			}
+
+			//the row functions are kept free of branches and function calls so that the compiler can vectorise them
+			SV_ROW_FUNCTION void assignRow(uchar const* source, float weight, float* sums, int count) {
+#pragma omp simd
+				for (int i = 0; i < count; ++i) {
+					sums[i] = weight * float(source[i]);
+				}
+			}
+
+			SV_ROW_FUNCTION void accumulateRow(uchar const* source, float weight, float* sums, int count) {
+#pragma omp simd
+				for (int i = 0; i < count; ++i) {
+					sums[i] += weight * float(source[i]);
+				}
+			}
+
+			inline void store(float value, uchar& destination) {
+				destination = uchar(std::min(value + 0.5f, 255.0f));
+			}
+
+			inline void store(float value, float& destination) {
+				destination = value;
+			}
+
+			template <int channels, typename T>
+			void reduceRow(float const* sums, T* destination, AxisWeights const& columns) {
+				int const width = int(columns.first.size());
+				for (int x = 0; x < width; ++x) {
+					float const* weights = columns.weights.data() + columns.offset[x];
+					float const* values = sums + columns.first[x] * channels;
+					float total[channels] = {};
+					for (int tap = 0; tap < columns.count[x]; ++tap) {
+						for (int channel = 0; channel < channels; ++channel) {
+							total[channel] += weights[tap] * values[tap * channels + channel];
+						}
+					}
+					for (int channel = 0; channel < channels; ++channel) {
+						store(total[channel], destination[x * channels + channel]);
+					}
+				}
+			}
+
+			///Computes row \p y of the downscaled image into \p destination, \p sums must hold a source row.
+			template <int channels, typename T>
+			void downscaleRow(cv::Mat const& source, AxisWeights const& rows, AxisWeights const& columns, int y, float* sums, T* destination) {
+				int const valuesPerRow = source.cols * channels;
+				float const* weights = rows.weights.data() + rows.offset[y];
+				assignRow(source.ptr<uchar>(rows.first[y]), weights[0], sums, valuesPerRow);
+				for (int tap = 1; tap < rows.count[y]; ++tap) {
+					accumulateRow(source.ptr<uchar>(rows.first[y] + tap), weights[tap], sums, valuesPerRow);
+				}
+				reduceRow<channels>(sums, destination, columns);
+			}
+
+			///Returns the index of the calling thread within the team of the enclosing parallel region, 0 outside of one.
+			int threadIndex() {
+#ifdef _OPENMP
+				return omp_get_thread_num();
+#else
+				return 0;
+#endif
+			}
+
+			///Buffers of given sizes for every thread of a parallel region.
+			/**
+			 * They are allocated before the region is entered: an exception thrown inside of it cannot be caught
+			 * outside and would terminate the program. The memory is released when the call is done.
+			 */
+			class ScratchArena {
+			public:
+				ScratchArena(int threads, std::initializer_list<size_t> sizes) {
+					for (size_t size : sizes) {
+						offsets.push_back(perThread);
+						perThread += size;
+					}
+					memory.resize(size_t(threads) * perThread);
+				}
+				///Returns the buffer \p index of the calling thread.
+				float* buffer(int index) {
+					return memory.data() + size_t(threadIndex()) * perThread + offsets[index];
+				}
+			private:
+				std::vector<float> memory;
+				std::vector<size_t> offsets;
+				size_t perThread = 0;
+			};
+
+			template <int channels>
+			void downscale(cv::Mat const& source, cv::Mat& destination) {
+				AxisWeights const rows = axisWeights(source.rows, destination.rows);
+				AxisWeights const columns = axisWeights(source.cols, destination.cols);
+				int const valuesPerRow = source.cols * channels;
+				int const destinationRows = destination.rows;
+				int const threads = ThreadPool::parallelThreadCount();
+				ScratchArena scratch(threads, { size_t(valuesPerRow) });
+#pragma omp parallel if (static_cast<long long>(source.rows) * valuesPerRow >= minimumParallelValues) num_threads(threads)
+				{
+					float* sums = scratch.buffer(0);
+					//static scheduling hands each thread one band of rows, so it reads a contiguous part of the source
+#pragma omp for schedule(static)
+					for (int y = 0; y < destinationRows; ++y) {
+						downscaleRow<channels>(source, rows, columns, y, sums, destination.ptr<uchar>(y));
+					}
+				}
+			}
+
+			///Maps a row or column index outside of [0, \p length) into it by mirroring without repeating the edge, which is the default border of \c cv::GaussianBlur.
+			int reflect(int index, int length) {
+				if (length == 1) return 0;
+				while (index < 0 || index >= length) {
+					if (index < 0) index = -index;
+					if (index >= length) index = 2 * length - 2 - index;
+				}
+				return index;
+			}
+
+			//horizontal blur of a row that has been padded by half the kernel size on both sides
+			SV_ROW_FUNCTION void blurRow(float const* padded, float const* kernel, int kernelSize, int channels, float* destination, int count) {
+				std::fill(destination, destination + count, 0.0f);
+				for (int tap = 0; tap < kernelSize; ++tap) {
+					float const weight = kernel[tap];
+					float const* values = padded + tap * channels;
+#pragma omp simd
+					for (int i = 0; i < count; ++i) {
+						destination[i] += weight * values[i];
+					}
+				}
+			}
+
+			SV_ROW_FUNCTION void unsharpRow(float const* image, float const* blurred, float strength, uchar* destination, int count) {
+#pragma omp simd
+				for (int i = 0; i < count; ++i) {
+					float value = (1.0f + strength) * image[i] - strength * blurred[i] + 0.5f;
+					value = value > 0.0f ? value : 0.0f;
+					value = value < 255.0f ? value : 255.0f;
+					destination[i] = uchar(int(value));
+				}
+			}
+
+			//premultiplied colour must not exceed alpha, the mask changes them independently
+			void clampToAlpha(uchar* pixels, int width) {
+				for (int x = 0; x < width; ++x) {
+					uchar* pixel = pixels + 4 * x;
+					pixel[0] = std::min(pixel[0], pixel[3]);
+					pixel[1] = std::min(pixel[1], pixel[3]);
+					pixel[2] = std::min(pixel[2], pixel[3]);
+				}
+			}
+
+			//the kernel size cv::GaussianBlur picks for 8 bit images when it is given only sigma
+			int sharpeningKernelSize(double sigma) {
+				return sigma > 0 ? std::max(1, cvRound(sigma * 6 + 1) | 1) : 1;
+			}
+
+			//number of destination rows sharpened together; the rows of the blur kernel that reach into the neighbouring strips are computed twice
+			constexpr int stripRows = 128;
+
+			///Downscales and applies an unsharp mask in one go, the sharpening works on the rows while they are still in the cache.
+			/**
+			 * Every thread keeps the last kernel size downscaled rows and their horizontally blurred versions in
+			 * a ring buffer. Each new row completes the vertical blur of the row half a kernel above it, which is
+			 * then combined with the unblurred row and written out. The intermediate values are not rounded.
+			 */
+			template <int channels>
+			void downscaleSharpened(cv::Mat const& source, cv::Mat& destination, float strength, double sigma, bool premultipliedAlpha) {
+				AxisWeights const rows = axisWeights(source.rows, destination.rows);
+				AxisWeights const columns = axisWeights(source.cols, destination.cols);
+				int const kernelSize = sharpeningKernelSize(sigma);
+				int const half = kernelSize / 2;
+				std::vector<float> kernel(kernelSize, 1.0f);
+				if (kernelSize > 1) {
+					cv::Mat kernelMat = cv::getGaussianKernel(kernelSize, sigma, CV_32F);
+					std::copy(kernelMat.ptr<float>(0), kernelMat.ptr<float>(0) + kernelSize, kernel.begin());
+				}
+				int const width = destination.cols;
+				int const height = destination.rows;
+				int const values = width * channels;
+				int const strips = (height + stripRows - 1) / stripRows;
+				int const threads = ThreadPool::parallelThreadCount();
+				ScratchArena scratch(threads, { size_t(source.cols) * channels, size_t(width + 2 * half) * channels, size_t(kernelSize) * values, size_t(kernelSize) * values, size_t(values) });
+#pragma omp parallel if (static_cast<long long>(source.rows) * source.cols * channels >= minimumParallelValues) num_threads(threads)
+				{
+					float* sums = scratch.buffer(0);
+					float* padded = scratch.buffer(1);
+					float* downscaled = scratch.buffer(2);
+					float* blurred = scratch.buffer(3);
+					float* vertical = scratch.buffer(4);
+					auto slot = [kernelSize](int position) { return ((position % kernelSize) + kernelSize) % kernelSize; };
+#pragma omp for schedule(static)
+					for (int strip = 0; strip < strips; ++strip) {
+						int const first = strip * stripRows;
+						int const last = std::min(height, first + stripRows);
+						for (int position = first - half; position < last + half; ++position) {
+							float* row = downscaled + size_t(slot(position)) * values;
+							downscaleRow<channels>(source, rows, columns, reflect(position, height), sums, row);
+							std::copy(row, row + values, padded + half * channels);
+							for (int column = 1; column <= half; ++column) {
+								std::copy_n(row + reflect(-column, width) * channels, channels, padded + (half - column) * channels);
+								std::copy_n(row + reflect(width - 1 + column, width) * channels, channels, padded + (half + width - 1 + column) * channels);
+							}
+							blurRow(padded, kernel.data(), kernelSize, channels, blurred + size_t(slot(position)) * values, values);
+							int const y = position - half;
+							if (y < first) continue;
+							std::fill(vertical, vertical + values, 0.0f);
+							for (int tap = 0; tap < kernelSize; ++tap) {
+								float const weight = kernel[tap];
+								float const* blurredRow = blurred + size_t(slot(y - half + tap)) * values;
+#pragma omp simd
+								for (int i = 0; i < values; ++i) {
+									vertical[i] += weight * blurredRow[i];
+								}
+							}
+							unsharpRow(downscaled + size_t(slot(y)) * values, vertical, strength, destination.ptr<uchar>(y), values);
+							if (channels == 4 && premultipliedAlpha) clampToAlpha(destination.ptr<uchar>(y), width);
+						}
+					}
+				}
+			}
+
+			///Returns the factor range and whether the factor is an integer, cv::resize has a separate code path for those.
+			void classify(cv::Size const& sourceSize, cv::Size const& size, int& range, int& integer) {
+				double inverseFactor = std::min(double(sourceSize.width) / size.width, double(sourceSize.height) / size.height);
+				range = std::clamp(int(std::floor(std::log2(std::max(inverseFactor, 1.0)))), 0, factorRangeCount - 1);
+				integer = sourceSize.width % size.width == 0 && sourceSize.height % size.height == 0 ? 1 : 0;
+			}
+
+			///Returns the shortest of a few runs of \p function in milliseconds, the others are disturbed by caches warming up or other threads.
+			template <typename Function>
+			double measure(Function function) {
+				double best = std::numeric_limits<double>::max();
+				for (int run = 0; run < 3; ++run) {
+					std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+					function();
+					best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+				}
+				return best;
+			}
+
+		}
+
+		bool areaDownscale(cv::Mat const& source, cv::Mat& destination, cv::Size const& size) {
+			if (source.depth() != CV_8U || source.channels() > 4 || source.empty() || size.width <= 0 || size.height <= 0) return false;
+			if (size.width > source.cols || size.height > source.rows || size == source.size()) return false;
+			cv::Mat result(size, source.type());
+			switch (source.channels()) {
+				case 1:
+					downscale<1>(source, result);
+					break;
+				case 2:
+					downscale<2>(source, result);
+					break;
+				case 3:
+					downscale<3>(source, result);
+					break;
+				default:
+					downscale<4>(source, result);
+			}
+			destination = result;
+			return true;
+		}
+
+		bool areaDownscaleSharpened(cv::Mat const& source, cv::Mat& destination, cv::Size const& size, double strength, double radius, bool premultipliedAlpha) {
+			if (source.depth() != CV_8U || source.channels() > 4 || source.empty() || size.width <= 0 || size.height <= 0) return false;
+			if (sharpeningKernelSize(radius) > maximumFusedKernelSize) return false;
+			if (size.width > source.cols || size.height > source.rows || size == source.size()) return false;
+			cv::Mat result(size, source.type());
+			switch (source.channels()) {
+				case 1:
+					downscaleSharpened<1>(source, result, float(strength), radius, false);
+					break;
+				case 2:
+					downscaleSharpened<2>(source, result, float(strength), radius, false);
+					break;
+				case 3:
+					downscaleSharpened<3>(source, result, float(strength), radius, false);
+					break;
+				default:
+					downscaleSharpened<4>(source, result, float(strength), radius, premultipliedAlpha);
+			}
+			destination = result;
+			return true;
+		}
+
+		void resize(cv::Mat const& source, cv::Mat& destination, cv::Size const& size) {
+			if (calibrated && !source.empty() && size.width > 0 && size.height > 0) {
+				int range, integer;
+				classify(source.size(), size, range, integer);
+				if (useOwnKernel[range][integer] && areaDownscale(source, destination, size)) return;
+			}
+			cv::resize(source, destination, size, 0, 0, cv::INTER_AREA);
+		}
+
+		void calibrate() {
+			static std::once_flag once;
+			std::call_once(once, []() {
+				//about the size of a photo fitted to a screen from twice the size, so the caches behave as they do in practice
+				cv::Mat image(1536, 2048, CV_8UC3);
+				cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+				//a representative integer and non-integer inverse factor for each range, 1 is no reduction
+				double const integerFactors[factorRangeCount] = { 1, 2, 4, 8 };
+				double const otherFactors[factorRangeCount] = { 1.4, 2.7, 5.3, 10.6 };
+				for (int range = 0; range < factorRangeCount; ++range) {
+					for (int integer = 0; integer < 2; ++integer) {
+						double inverseFactor = integer ? integerFactors[range] : otherFactors[range];
+						if (inverseFactor == 1) continue;
+						cv::Size size(int(image.cols / inverseFactor), int(image.rows / inverseFactor));
+						cv::Mat result;
+						double own = measure([&]() { areaDownscale(image, result, size); });
+						double library = measure([&]() { cv::resize(image, result, size, 0, 0, cv::INTER_AREA); });
+						useOwnKernel[range][integer] = own < library;
+					}
+				}
+				calibrated = true;
+			});
+		}
+
+	}
+
+}
\ No newline at end of file
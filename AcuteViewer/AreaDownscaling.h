@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <initializer_list>
+
+//OpenCV
+#include <opencv2/core.hpp>
+
+#include "ThreadPool.h"
+
+namespace sv {
+
+	namespace downscaling {
+
+		///Downscales \p source to \p size by averaging the source pixels each destination pixel covers, like \c cv::INTER_AREA.
+		/**
+		 * Supports 8 bit images with one to four channels; returns false without touching \p destination for
+		 * anything else, including sizes that are not a reduction. Rows are first summed vertically into a float
+		 * row, which is where nearly all of the work is done and which the compiler vectorises for whatever
+		 * instruction set it targets, then reduced horizontally. Large images are split into bands of
+		 * destination rows that are computed in parallel.
+		 */
+		bool areaDownscale(cv::Mat const& source, cv::Mat& destination, cv::Size const& size);
+
+		///Downscales like \c areaDownscale() and sharpens the result with an unsharp mask of \p strength and Gaussian \p radius on the way.
+		/**
+		 * Gives the same result as \c cv::GaussianBlur() followed by \c cv::addWeighted() on the downscaled image,
+		 * without rounding in between, but processes the image in strips of rows whose intermediate results stay
+		 * in the cache, so the sharpening adds little to the downscale. Returns false for the same cases as
+		 * \c areaDownscale() and for radii whose kernel exceeds \c maximumFusedKernelSize. If \p premultipliedAlpha
+		 * is set, the colour channels of a four channel image are clamped to its alpha after sharpening.
+		 */
+		bool areaDownscaleSharpened(cv::Mat const& source, cv::Mat& destination, cv::Size const& size, double strength, double radius, bool premultipliedAlpha = false);
+
+		//above this kernel size (a radius of 1.67) every strip recomputes so many rows of its neighbours that sharpening
+		//the downscaled image separately is faster, so areaDownscaleSharpened() returns false
+		constexpr int maximumFusedKernelSize = 11;
+
+		///Downscales \p source to \p size with \c areaDownscale() or \c cv::resize(), whichever \c calibrate() found faster for the scaling factor.
+		/**
+		 * Until the calibration has finished, \c cv::resize() is used.
+		 */
+		void resize(cv::Mat const& source, cv::Mat& destination, cv::Size const& size);
+
+		///Measures \c areaDownscale() and \c cv::resize() on a synthetic image for a range of scaling factors.
+		/**
+		 * Takes a fraction of a second; only the first call does the work, later ones return immediately.
+		 */
+		void calibrate();
+
+	}
+
+}
\ No newline at end of file
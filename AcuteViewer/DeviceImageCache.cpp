@@ -0,0 +1,125 @@
+#include "DeviceImageCache.h"
+
+namespace hb {
+
+	DeviceImageCache::DeviceImageCache(size_t budget)
+		: budget(budget) { }
+
+	///Returns the device copy of \p image, which is identified by \p generation; uploads it first if it is not resident yet.
+	/**
+	 * Every call must be matched by a call to \c release() once the returned buffer is no longer read.
+	 */
+	cv::UMat DeviceImageCache::acquire(cv::Mat const& image, unsigned int generation) {
+		std::lock_guard<std::mutex> lock(mutex);
+		for (Entry& entry : entries) {
+			if (entry.generation == generation) {
+				++entry.users;
+				entry.lastUse = ++useCounter;
+				return entry.buffer;
+			}
+		}
+		Entry* target = nullptr;
+		for (Entry& entry : entries) {
+			//the buffer of an image that is no longer needed can take the new one without reallocating
+			if (entry.users == 0 && entry.buffer.size() == image.size() && entry.buffer.type() == image.type()) {
+				target = &entry;
+				break;
+			}
+		}
+		if (target == nullptr) {
+			entries.push_back(Entry{ generation, cv::UMat(), 0, 0 });
+			target = &entries.back();
+		}
+		target->generation = generation;
+		target->users = 1;
+		target->lastUse = ++useCounter;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		try {
+			image.copyTo(target->buffer);
+		} catch (...) {
+			entries.erase(entries.begin() + (target - entries.data()));
+			throw;
+		}
+		updateAverage(uploadTime, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / (image.total() / 1000000.0));
+		cv::UMat result = target->buffer;
+		trim();
+		return result;
+	}
+
+	void DeviceImageCache::release(unsigned int generation) {
+		std::lock_guard<std::mutex> lock(mutex);
+		for (Entry& entry : entries) {
+			if (entry.generation == generation && entry.users > 0) {
+				--entry.users;
+				break;
+			}
+		}
+		trim();
+	}
+
+	bool DeviceImageCache::isResident(unsigned int generation) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		for (Entry const& entry : entries) {
+			if (entry.generation == generation) return true;
+		}
+		return false;
+	}
+
+	///Releases all device memory; buffers that are still read from are freed once their last user is done.
+	void DeviceImageCache::clear() {
+		std::lock_guard<std::mutex> lock(mutex);
+		entries.clear();
+	}
+
+	///Returns whether resizing an image with \p pixels pixels is expected to be faster on the device, including the upload unless it is \p resident.
+	/**
+	 * As long as one of the two has not been measured yet, that one is chosen, so both get measured early on.
+	 */
+	bool DeviceImageCache::preferDevice(size_t pixels, bool resident) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (cpuTime < 0) return false;
+		if (deviceTime < 0) return true;
+		double megapixels = pixels / 1000000.0;
+		double device = deviceTime * megapixels;
+		if (!resident && uploadTime > 0) device += uploadTime * megapixels / expectedResizesPerUpload;
+		return device < cpuTime * megapixels;
+	}
+
+	void DeviceImageCache::registerCpuResize(size_t pixels, double milliseconds) {
+		if (pixels == 0) return;
+		std::lock_guard<std::mutex> lock(mutex);
+		updateAverage(cpuTime, milliseconds / (pixels / 1000000.0));
+	}
+
+	void DeviceImageCache::registerDeviceResize(size_t pixels, double milliseconds) {
+		if (pixels == 0) return;
+		std::lock_guard<std::mutex> lock(mutex);
+		updateAverage(deviceTime, milliseconds / (pixels / 1000000.0));
+	}
+
+	//=============================================================================== PRIVATE ===============================================================================\\
+
+	///Releases the least recently used idle buffers until the total size is within the budget; the mutex must be held.
+	void DeviceImageCache::trim() {
+		auto totalSize = [this]() {
+			size_t total = 0;
+			for (Entry const& entry : entries) {
+				total += entry.buffer.total() * entry.buffer.elemSize();
+			}
+			return total;
+		};
+		while (totalSize() > budget) {
+			auto oldest = entries.end();
+			for (auto entry = entries.begin(); entry != entries.end(); ++entry) {
+				if (entry->users == 0 && (oldest == entries.end() || entry->lastUse < oldest->lastUse)) oldest = entry;
+			}
+			if (oldest == entries.end()) return;
+			entries.erase(oldest);
+		}
+	}
+
+	void DeviceImageCache::updateAverage(double& average, double value) {
+		average = average < 0 ? value : 0.7 * average + 0.3 * value;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+//OpenCV
+#include <opencv2/core.hpp>
+
+namespace hb {
+
+	///Keeps images resident in OpenCL memory for downscaling and decides from measured timings whether that is worth it.
+	/**
+	 * Images are only uploaded when a resize on the device is actually requested. Buffers of images
+	 * that are no longer displayed are reused for the next image of the same size and type, and idle
+	 * buffers are released once the total exceeds the budget. Whether the device is used is decided by
+	 * comparing the measured time per megapixel of device and CPU resizes. Only the generic \c cv::UMat
+	 * interface is used, so this works with any OpenCL implementation, including CPU-only ones.
+	 * All functions are thread safe.
+	 */
+	class DeviceImageCache {
+	public:
+		DeviceImageCache(size_t budget = 512 * 1024 * 1024);
+		DeviceImageCache(DeviceImageCache const& other) = delete;
+		DeviceImageCache& operator=(DeviceImageCache const& other) = delete;
+		cv::UMat acquire(cv::Mat const& image, unsigned int generation);
+		void release(unsigned int generation);
+		bool isResident(unsigned int generation) const;
+		void clear();
+		bool preferDevice(size_t pixels, bool resident) const;
+		void registerCpuResize(size_t pixels, double milliseconds);
+		void registerDeviceResize(size_t pixels, double milliseconds);
+	private:
+		//functions
+		void trim();
+		static void updateAverage(double& average, double value);
+
+		//variables
+		struct Entry {
+			unsigned int generation;
+			cv::UMat buffer;
+			//number of resizes that currently read from the buffer, it must not be overwritten while they run
+			int users;
+			unsigned long long lastUse;
+		};
+		std::vector<Entry> entries;
+		size_t budget;
+		unsigned long long useCounter = 0;
+		//moving averages in milliseconds per megapixel, negative while nothing was measured yet
+		double cpuTime = -1;
+		double deviceTime = -1;
+		double uploadTime = -1;
+		//an upload pays off over the following zoom steps, which reuse the resident image
+		static constexpr double expectedResizesPerUpload = 4;
+		mutable std::mutex mutex;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,337 @@
+#include "DirectoryModel.h"
+
+namespace sv {
+
+	DirectoryModel::DirectoryModel(std::shared_ptr<ThreadPool> threadPool, int priority, QObject* parent)
+		: QObject(parent),
+		threadPool(threadPool),
+		priority(priority) {
+		collator.setNumericMode(true);
+	}
+
+	DirectoryModel::~DirectoryModel() {
+		stopWatching();
+		//the listing refers to this object, it must not outlive it
+		cancelListing();
+	}
+
+	///Makes \p directory the listed folder, only files matching \p filters are included; returns true if the folder is being listed.
+	/**
+	 * If the folder and filters are the ones already set and the folder is being watched, the list is
+	 * known to be current and nothing is done. Otherwise the list is empty until \c listingFinished is emitted.
+	 */
+	bool DirectoryModel::setDirectory(QDir const& directory, QStringList const& filters) {
+		if (hasDirectory && directory == currentDirectory && filters == nameFilters && isWatching()) return false;
+		stopWatching();
+		cancelListing();
+		currentDirectory = directory;
+		nameFilters = filters;
+		hasDirectory = true;
+		fileList.clear();
+		sortKeys.clear();
+		//watch first, so nothing that happens while listing is missed
+		startWatching();
+		startListing();
+		return true;
+	}
+
+	///Forgets the folder and stops watching it.
+	void DirectoryModel::clear() {
+		stopWatching();
+		cancelListing();
+		hasDirectory = false;
+		fileList.clear();
+		sortKeys.clear();
+	}
+
+	QVector<QString> const& DirectoryModel::files() const {
+		return fileList;
+	}
+
+	QDir const& DirectoryModel::directory() const {
+		return currentDirectory;
+	}
+
+	bool DirectoryModel::isWatching() const {
+		return inotifyNotifier != nullptr || (watcher != nullptr && !watcher->directories().isEmpty());
+	}
+
+	///Returns true while the folder is listed in the background.
+	bool DirectoryModel::isListing() const {
+		return listing;
+	}
+
+	///Removes \p name from the list without emitting \c fileRemoved, for files the caller deleted or moved itself.
+	void DirectoryModel::removeFile(QString const& name) {
+		if (listing) {
+			pendingChanges.insert(name, false);
+			return;
+		}
+		int index = indexOf(name);
+		if (index >= 0) removeAt(index);
+	}
+
+	//=============================================================================== PRIVATE ===============================================================================\\
+
+	void DirectoryModel::startListing() {
+		listing = true;
+		pendingChanges.clear();
+		synchronizeAfterListing = false;
+		listingCancellation = ThreadPool::makeCancellationToken();
+		ThreadPool::CancellationToken cancellation = listingCancellation;
+		unsigned int generation = ++listingGeneration;
+		QDir directory = currentDirectory;
+		QStringList filters = nameFilters;
+		QLocale locale = collator.locale();
+		listingTask = threadPool->enqueue([this, directory, filters, locale, cancellation, generation]() {
+			QStringList contents = DirectoryModel::listDirectory(directory, filters, cancellation);
+			if (*cancellation) return;
+			std::shared_ptr<Listing> result = DirectoryModel::sortListing(contents, locale, cancellation);
+			if (!result) return;
+			QMetaObject::invokeMethod(this, [this, generation, result]() { applyListing(generation, result); }, Qt::QueuedConnection);
+		}, priority);
+	}
+
+	void DirectoryModel::cancelListing() {
+		++listingGeneration;
+		listing = false;
+		if (!listingTask) return;
+		*listingCancellation = true;
+		if (!threadPool->cancel(listingTask)) threadPool->wait(listingTask);
+		listingTask.reset();
+	}
+
+	///Takes over the sorted \p result of a listing, together with the changes reported while it ran.
+	void DirectoryModel::applyListing(unsigned int generation, std::shared_ptr<Listing> const& result) {
+		if (generation != listingGeneration) return;
+		listing = false;
+		listingTask.reset();
+		fileList = result->names;
+		sortKeys = std::move(result->keys);
+		for (auto change = pendingChanges.constBegin(); change != pendingChanges.constEnd(); ++change) {
+			int index = indexOf(change.key());
+			if (change.value() && index < 0) {
+				insertSorted(change.key());
+			} else if (!change.value() && index >= 0) {
+				removeAt(index);
+			}
+		}
+		pendingChanges.clear();
+		emit(listingFinished());
+		if (synchronizeAfterListing) {
+			synchronizeAfterListing = false;
+			synchronize();
+		}
+	}
+
+	///Returns the names of the files in \p directory that match \p filters, in the order the file system returns them.
+	/**
+	 * Sorting is left to the caller; \c QDir::entryList() would sort by name, which is wasted when the
+	 * list is sorted naturally afterwards. On most file systems the file type comes with the directory
+	 * entry, so no file has to be opened or examined.
+	 */
+	QStringList DirectoryModel::listDirectory(QDir const& directory, QStringList const& filters, ThreadPool::CancellationToken cancellation) {
+		QStringList contents;
+		QDirIterator iterator(directory.absolutePath(), filters, QDir::Files);
+		while (iterator.hasNext()) {
+			if (cancellation && *cancellation) return QStringList();
+			iterator.next();
+			contents.append(iterator.fileName());
+		}
+		return contents;
+	}
+
+	///Sorts \p names naturally for \p locale; returns null if \p cancellation is set on the way.
+	/**
+	 * The sort keys are computed in parallel, each thread with a collator of its own since a collator
+	 * must not be used by several threads at once. Sorting then only compares the keys.
+	 */
+	std::shared_ptr<DirectoryModel::Listing> DirectoryModel::sortListing(QStringList const& names, QLocale const& locale, ThreadPool::CancellationToken cancellation) {
+		int const count = int(names.size());
+		//QCollatorSortKey cannot be default constructed
+		std::vector<std::optional<QCollatorSortKey>> keys(count);
+#pragma omp parallel if (count >= 4096) num_threads(ThreadPool::parallelThreadCount())
+		{
+			QCollator threadCollator(locale);
+			threadCollator.setNumericMode(true);
+#pragma omp for schedule(static)
+			for (int i = 0; i < count; ++i) {
+				if (*cancellation) continue;
+				keys[i] = threadCollator.sortKey(names.at(i));
+			}
+		}
+		if (*cancellation) return nullptr;
+		std::vector<int> order(count);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&keys](int a, int b) { return *keys[a] < *keys[b]; });
+		std::shared_ptr<Listing> result = std::make_shared<Listing>();
+		result->names.reserve(count);
+		result->keys.reserve(count);
+		for (int index : order) {
+			result->names.append(names.at(index));
+			result->keys.push_back(std::move(*keys[index]));
+		}
+		return result;
+	}
+
+	void DirectoryModel::startWatching() {
+#ifdef Q_OS_LINUX
+		inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (inotifyDescriptor >= 0) {
+			QByteArray path = QFile::encodeName(currentDirectory.absolutePath());
+			if (inotify_add_watch(inotifyDescriptor, path.constData(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | IN_MOVE_SELF) >= 0) {
+				inotifyNotifier = new QSocketNotifier(inotifyDescriptor, QSocketNotifier::Read, this);
+				QObject::connect(inotifyNotifier, &QSocketNotifier::activated, this, &DirectoryModel::readInotifyEvents);
+				return;
+			}
+			//e.g. the per user limit of watches is reached
+			close(inotifyDescriptor);
+			inotifyDescriptor = -1;
+		}
+#endif
+		watcher = new QFileSystemWatcher(this);
+		QObject::connect(watcher, SIGNAL(directoryChanged(QString)), this, SLOT(reactToDirectoryChange()));
+		watcher->addPath(currentDirectory.absolutePath());
+	}
+
+	void DirectoryModel::stopWatching() {
+		if (inotifyNotifier != nullptr) {
+			delete inotifyNotifier;
+			inotifyNotifier = nullptr;
+		}
+#ifdef Q_OS_LINUX
+		if (inotifyDescriptor >= 0) {
+			close(inotifyDescriptor);
+			inotifyDescriptor = -1;
+		}
+#endif
+		if (watcher != nullptr) {
+			delete watcher;
+			watcher = nullptr;
+		}
+	}
+
+	///Lists the folder again and applies the differences to the list, emitting the signals for them.
+	/**
+	 * If the folder itself no longer exists at its path, e.g. because it was renamed, it is not watched
+	 * anymore and the list is kept; see \c readInotifyEvents().
+	 */
+	void DirectoryModel::synchronize() {
+		if (listing) {
+			synchronizeAfterListing = true;
+			return;
+		}
+		if (!QFileInfo(currentDirectory.absolutePath()).isDir()) {
+			stopWatching();
+			return;
+		}
+		QStringList contents = listDirectory(currentDirectory, nameFilters);
+		QSet<QString> present(contents.begin(), contents.end());
+		QSet<QString> known(fileList.begin(), fileList.end());
+		for (QString const& name : known) {
+			if (!present.contains(name)) eraseFile(name);
+		}
+		for (QString const& name : contents) {
+			if (!known.contains(name)) insertFile(name);
+		}
+	}
+
+	void DirectoryModel::insertFile(QString const& name) {
+		if (listing) {
+			pendingChanges.insert(name, true);
+			return;
+		}
+		if (indexOf(name) >= 0) return;
+		int index = insertSorted(name);
+		emit(fileAdded(name, index));
+	}
+
+	void DirectoryModel::eraseFile(QString const& name) {
+		if (listing) {
+			pendingChanges.insert(name, false);
+			return;
+		}
+		int index = indexOf(name);
+		if (index < 0) return;
+		removeAt(index);
+		emit(fileRemoved(name, index));
+	}
+
+	int DirectoryModel::indexOf(QString const& name) const {
+		QCollatorSortKey key = collator.sortKey(name);
+		auto range = std::equal_range(sortKeys.begin(), sortKeys.end(), key);
+		//the numeric collation considers e.g. "a01" and "a1" equal, so the exact name is searched among the equal ones
+		for (auto position = range.first; position != range.second; ++position) {
+			int index = int(position - sortKeys.begin());
+			if (fileList[index] == name) return index;
+		}
+		return -1;
+	}
+
+	///Inserts \p name at its sorted position and returns it.
+	int DirectoryModel::insertSorted(QString const& name) {
+		QCollatorSortKey key = collator.sortKey(name);
+		auto position = std::upper_bound(sortKeys.begin(), sortKeys.end(), key);
+		int index = int(position - sortKeys.begin());
+		fileList.insert(index, name);
+		sortKeys.insert(position, key);
+		return index;
+	}
+
+	void DirectoryModel::removeAt(int index) {
+		fileList.remove(index);
+		sortKeys.erase(sortKeys.begin() + index);
+	}
+
+	bool DirectoryModel::matchesFilters(QString const& name) const {
+		return QDir::match(nameFilters, name);
+	}
+
+	//============================================================================ PRIVATE SLOTS =============================================================================\\
+
+	void DirectoryModel::readInotifyEvents() {
+#ifdef Q_OS_LINUX
+		alignas(inotify_event) char buffer[16384];
+		bool needsSynchronization = false;
+		bool watchRemoved = false;
+		for (;;) {
+			ssize_t length = read(inotifyDescriptor, buffer, sizeof(buffer));
+			if (length <= 0) break;
+			for (char* position = buffer; position < buffer + length; ) {
+				inotify_event const* event = reinterpret_cast<inotify_event const*>(position);
+				position += sizeof(inotify_event) + event->len;
+				if (event->mask & IN_Q_OVERFLOW) {
+					//events were lost, only a new listing can tell what changed
+					needsSynchronization = true;
+					continue;
+				}
+				if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+					//the folder itself is gone, the next setDirectory() has to list it again
+					watchRemoved = true;
+					continue;
+				}
+				if (event->len == 0 || (event->mask & IN_ISDIR)) continue;
+				QString name = QFile::decodeName(event->name);
+				if (!matchesFilters(name)) continue;
+				if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+					insertFile(name);
+				} else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+					eraseFile(name);
+				}
+			}
+		}
+		if (watchRemoved) {
+			//a renamed folder still contains its files, listing the old path would report every one of them as removed;
+			//without a watch the list is stale and is kept as it is until the folder is set again
+			stopWatching();
+			return;
+		}
+		if (needsSynchronization) synchronize();
+#endif
+	}
+
+	void DirectoryModel::reactToDirectoryChange() {
+		synchronize();
+	}
+
+}
\ No newline at end of file
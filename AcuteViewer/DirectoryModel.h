@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <numeric>
+
+//Qt
+#include <QtCore>
+
+#ifdef Q_OS_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "ThreadPool.h"
+
+namespace sv {
+
+	///The naturally sorted list of image files in a folder, kept current through file system notifications instead of rescanning.
+	/**
+	 * The folder is listed once when it is set, on a worker thread so that the caller can go on decoding
+	 * the image that was opened; \c listingFinished is emitted once the list is complete. On Linux, inotify then reports the names of files that
+	 * were written or moved in and of files that were deleted or moved out, so each change is a single
+	 * sorted insertion or removal. Elsewhere, or if inotify is unavailable, \c QFileSystemWatcher reports
+	 * that the folder changed and the new listing is compared to the current one. If the folder itself is
+	 * renamed or deleted, watching stops and the list is kept but stale, so it is listed anew the next time
+	 * the folder is set. Files are only added
+	 * once they have been closed after writing, so images that are still being copied do not show up.
+	 * The collation sort key of every name is computed once, in parallel while listing, and kept, so
+	 * sorting and inserting only compare keys instead of calling the locale-aware comparison.
+	 */
+	class DirectoryModel : public QObject {
+		Q_OBJECT
+	public:
+		DirectoryModel(std::shared_ptr<ThreadPool> threadPool, int priority = 0, QObject* parent = nullptr);
+		DirectoryModel(DirectoryModel const& other) = delete;
+		DirectoryModel& operator=(DirectoryModel const& other) = delete;
+		~DirectoryModel();
+		bool setDirectory(QDir const& directory, QStringList const& filters);
+		void clear();
+		QVector<QString> const& files() const;
+		QDir const& directory() const;
+		bool isWatching() const;
+		bool isListing() const;
+		void removeFile(QString const& name);
+	private:
+		//a sorted listing together with the sort keys of the names
+		struct Listing {
+			QVector<QString> names;
+			std::vector<QCollatorSortKey> keys;
+		};
+
+		//functions
+		void startListing();
+		void cancelListing();
+		void applyListing(unsigned int generation, std::shared_ptr<Listing> const& result);
+		static QStringList listDirectory(QDir const& directory, QStringList const& filters, ThreadPool::CancellationToken cancellation = nullptr);
+		static std::shared_ptr<Listing> sortListing(QStringList const& names, QLocale const& locale, ThreadPool::CancellationToken cancellation);
+		void startWatching();
+		void stopWatching();
+		void synchronize();
+		void insertFile(QString const& name);
+		void eraseFile(QString const& name);
+		int indexOf(QString const& name) const;
+		int insertSorted(QString const& name);
+		void removeAt(int index);
+		bool matchesFilters(QString const& name) const;
+
+		//variables
+		QDir currentDirectory;
+		QStringList nameFilters;
+		QVector<QString> fileList;
+		//the sort key of each entry of fileList, at the same index
+		std::vector<QCollatorSortKey> sortKeys;
+		bool hasDirectory = false;
+		QCollator collator;
+		std::shared_ptr<ThreadPool> threadPool;
+		int priority;
+		ThreadPool::TaskHandle listingTask;
+		ThreadPool::CancellationToken listingCancellation;
+		//incremented whenever a listing is started or abandoned, so the result of an abandoned one is discarded
+		unsigned int listingGeneration = 0;
+		bool listing = false;
+		//changes reported while the folder is listed, applied to the result; true if the file was added
+		QHash<QString, bool> pendingChanges;
+		bool synchronizeAfterListing = false;
+		int inotifyDescriptor = -1;
+		QSocketNotifier* inotifyNotifier = nullptr;
+		QFileSystemWatcher* watcher = nullptr;
+	private slots:
+		void readInotifyEvents();
+		void reactToDirectoryChange();
+	signals:
+		void listingFinished();
+		void fileAdded(QString name, int index);
+		void fileRemoved(QString name, int index);
+	};
+
+}
\ No newline at end of file
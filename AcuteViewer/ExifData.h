@@ -1,70 +1,80 @@
-#pragma once
-
-#include <thread>
-#include <atomic>
-#include <iostream>
-#include <mutex>
-#include <condition_variable>
-
-//Qt
-#include <QtCore>
-
-//OpenCV
-#include <opencv2/core.hpp>
-#include <opencv2/imgcodecs.hpp>
-
-//Exiv2
-#include <exiv2/exiv2.hpp>
-
-#include "utility.h"
-
-namespace sv {
-
-	class ExifData : public QObject {
-		Q_OBJECT
-	public:
-		ExifData(QString const& filepath, bool launchDeferred = false);
-		ExifData(std::shared_ptr<std::vector<char>> buffer);
-		ExifData(ExifData const& other) = delete;
-		ExifData& operator=(ExifData const& other) = delete;
-		~ExifData();
-		void startLoading();
-		bool hasValue(QString const& key) const;
-		Exiv2::Value::UniquePtr value(QString const& key) const;
-		QString cameraModel() const;
-		QString lensModel() const;
-		QString exposureTime() const;
-		QString fNumber() const;
-		QString iso() const;
-		QString exposureBias() const;
-		QString focalLength() const;
-		QString focalLength35mmEquivalent() const;
-		QString captureDate() const;
-		QString resolution() const;
-		int orientation() const;
-		cv::Mat largestReadablePreviewImage();
-		bool hasExif() const;
-		bool hasPreviewImage() const;
-		bool isReady() const;
-		bool isDeferred() const;
-		void join();
-	private:
-		//functions
-		void launchThreadFromPath(QString const& filepath);
-		void load(QString filepath);
-		void loadFromBuffer(std::shared_ptr<std::vector<char>> buffer);
-		void readExifFromImage(Exiv2::Image::UniquePtr const image);
-
-		//variables
-		Exiv2::ExifData exifData;
-		cv::Mat preview;
-		bool previewAvailable = false;
-		std::thread thread;
-		QString cachedFilepath;
-		std::atomic<bool> ready{ false };
-		std::atomic<bool> deferred{ true };
-	signals:
-		void loadingFinished(ExifData* sender);
-	};
-
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <condition_variable>
+
+//Qt
+#include <QtCore>
+
+//OpenCV
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+//Exiv2
+#include <exiv2/exiv2.hpp>
+
+#include "utility.h"
+#include "ThreadPool.h"
+
+namespace sv {
+
+	class ExifData : public QObject {
+		Q_OBJECT
+	public:
+		ExifData(QString const& filepath, std::shared_ptr<ThreadPool> threadPool, int priority = 0, bool launchDeferred = false, ThreadPool::CancellationToken cancellation = nullptr);
+		ExifData(std::shared_ptr<utility::FileBuffer> buffer, std::shared_ptr<ThreadPool> threadPool, int priority = 0, ThreadPool::CancellationToken cancellation = nullptr);
+		ExifData(ExifData const& other) = delete;
+		ExifData& operator=(ExifData const& other) = delete;
+		~ExifData();
+		void startLoading();
+		void setReadPreviews(bool value);
+		bool hasValue(QString const& key) const;
+		Exiv2::Value::UniquePtr value(QString const& key) const;
+		QString cameraModel() const;
+		QString lensModel() const;
+		QString exposureTime() const;
+		QString fNumber() const;
+		QString iso() const;
+		QString exposureBias() const;
+		QString focalLength() const;
+		QString focalLength35mmEquivalent() const;
+		QString captureDate() const;
+		QString resolution() const;
+		int orientation() const;
+		cv::Mat largestReadablePreviewImage();
+		bool hasExif() const;
+		bool hasPreviewImage() const;
+		bool isReady() const;
+		bool isDeferred() const;
+		void join();
+	private:
+		//functions
+		void launchThreadFromPath(QString const& filepath);
+		void load(QString filepath);
+		void loadFromBuffer(std::shared_ptr<utility::FileBuffer> buffer);
+		void readExifFromImage(Exiv2::Image::UniquePtr const image);
+		bool isCancelled() const;
+
+		//variables
+		Exiv2::ExifData exifData;
+		cv::Mat preview;
+		bool previewAvailable = false;
+		//decoding the embedded previews takes most of the time, callers that only need the values can skip it
+		bool readPreviews = true;
+		std::shared_ptr<ThreadPool> threadPool;
+		ThreadPool::TaskHandle task;
+		int priority;
+		QString cachedFilepath;
+		std::atomic<bool> ready{ false };
+		std::atomic<bool> deferred{ true };
+		//set when this object is destroyed, the token when whoever requested the data no longer needs it
+		std::atomic<bool> cancelled{ false };
+		ThreadPool::CancellationToken cancellation;
+	signals:
+		void loadingFinished(ExifData* sender);
+	};
+
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "FileList.h"
+
+namespace sv {
+
+	///Replaces the list by \p names; files that were in the list before keep their id, duplicates are skipped.
+	/**
+	 * Nothing is done if the list is unchanged, which takes constant time if it still shares its data with \p names.
+	 */
+	void FileList::assign(QVector<QString> const& names) {
+		if (names == this->names) return;
+		QHash<QString, FileId> previousIds;
+		previousIds.swap(idByName);
+		this->names.clear();
+		ids.clear();
+		idsByBaseName.clear();
+		positions.clear();
+		stalePositionsFrom = std::numeric_limits<int>::max();
+		this->names.reserve(names.size());
+		ids.reserve(names.size());
+		for (QString const& name : names) {
+			if (idByName.contains(name)) continue;
+			FileId id = previousIds.value(name, 0);
+			if (id == 0) id = nextId++;
+			positions.insert(id, int(this->names.size()));
+			this->names.append(name);
+			ids.append(id);
+			idByName.insert(name, id);
+			idsByBaseName.insert(baseNameOf(name), id);
+		}
+		//without duplicates the names are the same, sharing them makes the next comparison cheap
+		if (this->names.size() == names.size()) this->names = names;
+	}
+
+	void FileList::clear() {
+		names.clear();
+		ids.clear();
+		idByName.clear();
+		idsByBaseName.clear();
+		positions.clear();
+		stalePositionsFrom = std::numeric_limits<int>::max();
+	}
+
+	int FileList::size() const {
+		return int(names.size());
+	}
+
+	bool FileList::isEmpty() const {
+		return names.isEmpty();
+	}
+
+	QString const& FileList::operator[](int index) const {
+		return names[index];
+	}
+
+	QString const& FileList::at(int index) const {
+		return names.at(index);
+	}
+
+	FileList::FileId FileList::id(int index) const {
+		return ids[index];
+	}
+
+	///Returns the index of the file called \p name, or -1 if it is not in the list.
+	int FileList::indexOf(QString const& name) const {
+		FileId id = idByName.value(name, 0);
+		if (id == 0) return -1;
+		return indexOf(id);
+	}
+
+	int FileList::indexOf(FileId id) const {
+		updatePositions();
+		return positions.value(id, -1);
+	}
+
+	///Returns the indices of the files whose name without extension is \p baseName, in no particular order.
+	QVector<int> FileList::indicesOfBaseName(QString const& baseName) const {
+		QVector<int> result;
+		for (FileId id : idsByBaseName.values(baseName)) {
+			result.append(indexOf(id));
+		}
+		return result;
+	}
+
+	void FileList::insert(int index, QString const& name) {
+		if (idByName.contains(name)) return;
+		FileId id = nextId++;
+		names.insert(index, name);
+		ids.insert(index, id);
+		idByName.insert(name, id);
+		idsByBaseName.insert(baseNameOf(name), id);
+		invalidatePositions(index);
+	}
+
+	void FileList::remove(int index) {
+		FileId id = ids[index];
+		QString name = names[index];
+		names.remove(index);
+		ids.remove(index);
+		idByName.remove(name);
+		idsByBaseName.remove(baseNameOf(name), id);
+		positions.remove(id);
+		invalidatePositions(index);
+	}
+
+	//=============================================================================== PRIVATE ===============================================================================\\
+
+	QString FileList::baseNameOf(QString const& name) {
+		//same as QFileInfo::baseName() without examining the file
+		return name.left(name.indexOf('.'));
+	}
+
+	void FileList::invalidatePositions(int from) {
+		stalePositionsFrom = std::min(stalePositionsFrom, from);
+	}
+
+	void FileList::updatePositions() const {
+		for (int index = stalePositionsFrom; index < ids.size(); ++index) {
+			positions.insert(ids[index], index);
+		}
+		stalePositionsFrom = std::numeric_limits<int>::max();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <limits>
+#include <algorithm>
+
+//Qt
+#include <QtCore>
+
+namespace sv {
+
+	///The ordered list of files that is navigated, with hash indexes so that finding a file never requires a scan.
+	/**
+	 * Every file gets an id that stays the same while it is in the list, also when the list is replaced
+	 * by one that contains it as well. Files can be looked up by name, by id and by base name (the part of
+	 * the name before the first dot, which sidecar files share with their image) in constant time. The
+	 * positions of the ids are brought up to date lazily, so a series of insertions or removals costs
+	 * a single pass over the files behind the first change, at the next lookup by id.
+	 */
+	class FileList {
+	public:
+		using FileId = quint64;
+		void assign(QVector<QString> const& names);
+		void clear();
+		int size() const;
+		bool isEmpty() const;
+		QString const& operator[](int index) const;
+		QString const& at(int index) const;
+		FileId id(int index) const;
+		int indexOf(QString const& name) const;
+		int indexOf(FileId id) const;
+		QVector<int> indicesOfBaseName(QString const& baseName) const;
+		void insert(int index, QString const& name);
+		void remove(int index);
+	private:
+		//functions
+		static QString baseNameOf(QString const& name);
+		void invalidatePositions(int from);
+		void updatePositions() const;
+
+		//variables
+		QVector<QString> names;
+		QVector<FileId> ids;
+		QHash<QString, FileId> idByName;
+		QMultiHash<QString, FileId> idsByBaseName;
+		//index of every id in the list; from stalePositionsFrom onwards they may be outdated
+		mutable QHash<FileId, int> positions;
+		mutable int stalePositionsFrom = std::numeric_limits<int>::max();
+		FileId nextId = 1;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "Image.h"
+
+namespace sv {
+
+	Image::Image() { }
+
+	Image::Image(cv::Mat mat, std::shared_ptr<ExifData> exifData, bool isPreviewImage, int reductionFactor, cv::Size fullSize)
+		: matrix(mat),
+		exifData(exifData),
+		valid(true),
+		previewImage(isPreviewImage),
+		reduction(reductionFactor),
+		originalSize(fullSize.empty() ? mat.size() : fullSize) { }
+
+	cv::Mat Image::mat() const {
+		return matrix;
+	}
+
+	std::shared_ptr<ExifData> Image::exif() const {
+		return exifData;
+	}
+
+	bool Image::isValid() const {
+		return valid;
+	}
+
+	bool Image::isPreviewImage() const {
+		return previewImage;
+	}
+
+	///Returns by which factor the resolution was reduced while decoding, 1 if the image was decoded at full resolution.
+	int Image::reductionFactor() const {
+		return reduction;
+	}
+
+	///Returns the resolution of the image in the file, which differs from the size of \c mat() for reduced decodes.
+	cv::Size Image::fullSize() const {
+		return originalSize;
+	}
+
+	///Returns how many pixels of the full resolution one pixel of \c mat() corresponds to.
+	double Image::pixelScale() const {
+		if (matrix.cols == 0) return 1;
+		return double(originalSize.width) / double(matrix.cols);
+	}
+
+	///Returns the number of bytes occupied by the decoded pixels.
+	size_t Image::byteSize() const {
+		return matrix.total() * matrix.elemSize();
+	}
+
+	///Specifies whether the colour channels of a four channel \c mat() are premultiplied by its alpha channel.
+	void Image::setAlphaPremultiplied(bool value) {
+		alphaPremultiplied = value;
+	}
+
+	bool Image::isAlphaPremultiplied() const {
+		return alphaPremultiplied;
+	}
+
+	///Specifies where the pixels of an image too large to be decoded as a whole are read from when zooming in; \c mat() is then only an overview.
+	void Image::setTileSource(std::shared_ptr<hb::TileSource> source) {
+		tiles = source;
+	}
+
+	std::shared_ptr<hb::TileSource> Image::tileSource() const {
+		return tiles;
+	}
+
+	///Specifies whether the image was decoded at a reduced resolution because it exceeds the size limit, in which case the full resolution must not be decoded.
+	void Image::setReducedToSizeLimit(bool value) {
+		reducedToSizeLimit = value;
+	}
+
+	bool Image::isReducedToSizeLimit() const {
+		return reducedToSizeLimit;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <future>
+
+//OpenCV
+#include <opencv2/core.hpp>
+
+#include "ExifData.h"
+#include "ThreadPool.h"
+#include "TileSource.h"
+
+namespace sv {
+
+	class Image {
+	public:
+		Image();
+		Image(cv::Mat mat, std::shared_ptr<ExifData> exifData, bool isPreviewImage = false, int reductionFactor = 1, cv::Size fullSize = cv::Size());
+		cv::Mat mat() const;
+		std::shared_ptr<ExifData> exif() const;
+		bool isValid() const;
+		bool isPreviewImage() const;
+		int reductionFactor() const;
+		cv::Size fullSize() const;
+		double pixelScale() const;
+		size_t byteSize() const;
+		void setAlphaPremultiplied(bool value);
+		bool isAlphaPremultiplied() const;
+		void setTileSource(std::shared_ptr<hb::TileSource> source);
+		std::shared_ptr<hb::TileSource> tileSource() const;
+		void setReducedToSizeLimit(bool value);
+		bool isReducedToSizeLimit() const;
+	private:
+		bool valid = false;
+		bool previewImage = false;
+		//the image was decoded at 1/reduction of its resolution
+		int reduction = 1;
+		cv::Size originalSize;
+		bool alphaPremultiplied = false;
+		//for images too large to be decoded as a whole, mat() is only an overview
+		std::shared_ptr<hb::TileSource> tiles;
+		bool reducedToSizeLimit = false;
+		cv::Mat matrix;
+		std::shared_ptr<ExifData> exifData;
+	};
+
+	//a decode job of the thread pool together with the future that delivers its result
+	struct ImageThread {
+		std::shared_future<Image> future;
+		ThreadPool::TaskHandle task;
+		ThreadPool::CancellationToken cancellation;
+	};
+
+}
\ No newline at end of file
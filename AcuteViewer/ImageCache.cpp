@@ -0,0 +1,107 @@
+#include "ImageCache.h"
+
+namespace sv {
+
+	ImageCache::ImageCache(size_t budget) : byteBudget(budget) { }
+
+	///Sets the number of bytes of decoded pixels that may be kept; takes effect with the next call to \c trim().
+	void ImageCache::setBudget(size_t bytes) {
+		byteBudget = bytes;
+	}
+
+	size_t ImageCache::budget() const {
+		return byteBudget;
+	}
+
+	///Returns the number of bytes occupied by the finished decodes as far as known at the last call to \c trim().
+	size_t ImageCache::usedBytes() const {
+		return byteCount;
+	}
+
+	size_t ImageCache::count() const {
+		return entries.size();
+	}
+
+	///Returns the entry for \p key and marks it as most recently used, or \c nullptr if there is none.
+	ImageThread* ImageCache::find(QString const& key) {
+		QHash<QString, Entry>::iterator it = entries.find(key);
+		if (it == entries.end()) return nullptr;
+		recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, it->position);
+		return &it->thread;
+	}
+
+	///Returns the entry for \p key without changing the order of eviction, or \c nullptr if there is none.
+	ImageThread* ImageCache::peek(QString const& key) {
+		QHash<QString, Entry>::iterator it = entries.find(key);
+		if (it == entries.end()) return nullptr;
+		return &it->thread;
+	}
+
+	void ImageCache::insert(QString const& key, ImageThread const& thread) {
+		remove(key);
+		recentlyUsed.push_front(key);
+		Entry entry;
+		entry.thread = thread;
+		entry.position = recentlyUsed.begin();
+		entries.insert(key, entry);
+	}
+
+	void ImageCache::remove(QString const& key) {
+		QHash<QString, Entry>::iterator it = entries.find(key);
+		if (it == entries.end()) return;
+		byteCount -= it->bytes;
+		recentlyUsed.erase(it->position);
+		entries.erase(it);
+	}
+
+	QStringList ImageCache::keys() const {
+		return entries.keys();
+	}
+
+	///Evicts least recently used images until the budget is met; \p pinnedKeys are never evicted.
+	/**
+	 * Decodes that are still running cannot be evicted. Returns \c false if the budget
+	 * could not be met because of such entries, \c true otherwise.
+	 */
+	bool ImageCache::trim(QSet<QString> const& pinnedKeys) {
+		//account for the decodes that finished since the last call
+		for (QHash<QString, Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+			if (it->bytes == 0 && it->thread.future.valid() && it->thread.future.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
+				//count at least one byte so finished entries are distinguishable from pending ones
+				it->bytes = std::max(size_t(1), it->thread.future.get().byteSize());
+				byteCount += it->bytes;
+			}
+		}
+		bool blocked = false;
+		std::list<QString>::iterator it = recentlyUsed.end();
+		while (byteCount > byteBudget && it != recentlyUsed.begin()) {
+			--it;
+			if (pinnedKeys.contains(*it)) continue;
+			QHash<QString, Entry>::iterator entry = entries.find(*it);
+			if (!isEvictable(*entry)) {
+				blocked = true;
+				continue;
+			}
+			byteCount -= entry->bytes;
+			entries.erase(entry);
+			it = recentlyUsed.erase(it);
+		}
+		return !blocked;
+	}
+
+	void ImageCache::clear() {
+		entries.clear();
+		recentlyUsed.clear();
+		byteCount = 0;
+	}
+
+	//=============================================================================== PRIVATE ===============================================================================\\
+
+	bool ImageCache::isEvictable(Entry const& entry) {
+		if (entry.bytes == 0) return false;
+		Image image = entry.thread.future.get();
+		//the exif should have finished loading as well, otherwise destroying it would block
+		return !image.isValid() || image.exif()->isReady() || image.exif()->isDeferred();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <list>
+
+//Qt
+#include <QtCore>
+
+#include "Image.h"
+
+namespace sv {
+
+	///Keeps decoded images (and the decodes still in progress) up to a budget of bytes, evicting the least recently used ones first.
+	class ImageCache {
+	public:
+		ImageCache(size_t budget = 0);
+		void setBudget(size_t bytes);
+		size_t budget() const;
+		size_t usedBytes() const;
+		size_t count() const;
+		ImageThread* find(QString const& key);
+		ImageThread* peek(QString const& key);
+		void insert(QString const& key, ImageThread const& thread);
+		void remove(QString const& key);
+		QStringList keys() const;
+		bool trim(QSet<QString> const& pinnedKeys);
+		void clear();
+	private:
+		struct Entry {
+			ImageThread thread;
+			//zero as long as the decode has not finished
+			size_t bytes = 0;
+			std::list<QString>::iterator position;
+		};
+
+		//functions
+		static bool isEvictable(Entry const& entry);
+
+		//variables
+		QHash<QString, Entry> entries;
+		//most recently used key at the front
+		std::list<QString> recentlyUsed;
+		size_t byteBudget;
+		size_t byteCount = 0;
+	};
+
+}
\ No newline at end of file
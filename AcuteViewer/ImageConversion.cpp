@@ -0,0 +1,115 @@
+#include "ImageConversion.h"
+
+//OpenCV
+#include <opencv2/imgproc.hpp>
+
+namespace sv {
+
+	namespace conversion {
+
+		namespace {
+
+			//below this number of values the cost of waking up the OpenMP team outweighs the gain
+			constexpr long long minimumParallelValues = 1 << 20;
+
+			///Returns a table that maps every 16 bit value to its 8 bit counterpart after applying \p gamma.
+			std::shared_ptr<std::vector<uchar> const> gammaTable(double gamma) {
+				static std::mutex mutex;
+				static double tableGamma = 0;
+				static std::shared_ptr<std::vector<uchar> const> table;
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!table || tableGamma != gamma) {
+					std::shared_ptr<std::vector<uchar>> newTable = std::make_shared<std::vector<uchar>>(65536);
+					double exponent = 1.0 / gamma;
+					for (int value = 0; value < 65536; ++value) {
+						(*newTable)[value] = uchar(std::lround(255.0 * std::pow(value / 65535.0, exponent)));
+					}
+					table = newTable;
+					tableGamma = gamma;
+				}
+				return table;
+			}
+
+			//the row functions are kept free of branches and function calls so that the compiler can vectorise them
+			void narrowRow(ushort const* source, uchar* destination, int count) {
+				for (int i = 0; i < count; ++i) {
+					int value = (int(source[i]) + 128) >> 8;
+					destination[i] = uchar(value < 255 ? value : 255);
+				}
+			}
+
+			void narrowRow(float const* source, uchar* destination, int count) {
+				for (int i = 0; i < count; ++i) {
+					float value = source[i] * 256.0f + 0.5f;
+					//written so that NaN ends up as 0
+					value = value > 0.0f ? value : 0.0f;
+					value = value < 255.0f ? value : 255.0f;
+					destination[i] = uchar(int(value));
+				}
+			}
+
+			void narrowRow(ushort const* source, uchar* destination, int count, uchar const* table) {
+				for (int i = 0; i < count; ++i) {
+					destination[i] = table[source[i]];
+				}
+			}
+
+			void narrowRow(float const* source, uchar* destination, int count, uchar const* table) {
+				for (int i = 0; i < count; ++i) {
+					float value = source[i] * 65535.0f + 0.5f;
+					value = value > 0.0f ? value : 0.0f;
+					value = value < 65535.0f ? value : 65535.0f;
+					destination[i] = table[int(value)];
+				}
+			}
+
+			template <typename T>
+			void narrow(cv::Mat const& source, cv::Mat& destination, uchar const* table) {
+				int const rows = source.rows;
+				int const valuesPerRow = source.cols * source.channels();
+				//static scheduling hands each thread one contiguous block of rows, which keeps the accesses sequential
+#pragma omp parallel for schedule(static) if (static_cast<long long>(rows) * valuesPerRow >= minimumParallelValues) num_threads(ThreadPool::parallelThreadCount())
+				for (int row = 0; row < rows; ++row) {
+					if (table) {
+						narrowRow(source.ptr<T>(row), destination.ptr<uchar>(row), valuesPerRow, table);
+					} else {
+						narrowRow(source.ptr<T>(row), destination.ptr<uchar>(row), valuesPerRow);
+					}
+				}
+			}
+
+		}
+
+		cv::Mat toEightBit(cv::Mat const& image, double gamma) {
+			if (image.depth() != CV_16U && image.depth() != CV_32F) return image;
+			cv::Mat result(image.rows, image.cols, CV_MAKETYPE(CV_8U, image.channels()));
+			std::shared_ptr<std::vector<uchar> const> table;
+			if (gamma > 0 && gamma != 1.0) table = gammaTable(gamma);
+			uchar const* tableData = table ? table->data() : nullptr;
+			if (image.depth() == CV_16U) {
+				narrow<ushort>(image, result, tableData);
+			} else {
+				narrow<float>(image, result, tableData);
+			}
+			return result;
+		}
+
+		cv::Mat toPremultipliedBgra(cv::Mat const& image) {
+			if (image.depth() != CV_8U) return image;
+			cv::Mat result;
+			if (image.channels() == 1) {
+				cv::cvtColor(image, result, cv::COLOR_GRAY2BGRA);
+			} else if (image.channels() == 3) {
+				cv::cvtColor(image, result, cv::COLOR_BGR2BGRA);
+			} else if (image.channels() == 4) {
+				//the alpha channel is the fourth one in either order, so the RGBA conversion works for BGRA as well
+				cv::cvtColor(image, result, cv::COLOR_RGBA2mRGBA);
+			} else {
+				return image;
+			}
+			return result;
+		}
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cmath>
+#include <algorithm>
+
+//OpenCV
+#include <opencv2/core.hpp>
+
+#include "ThreadPool.h"
+
+namespace sv {
+
+	namespace conversion {
+
+		///Narrows a 16 bit or floating point image to 8 bit per channel in a single pass; other images are returned as they are.
+		/**
+		 * 16 bit values are divided by 256, floating point values multiplied by 256, both rounded and saturated,
+		 * which is what \c cv::Mat::convertTo does. If \p gamma is not 1, the values are normalised to [0, 1]
+		 * and raised to the power of 1 / \p gamma on the way, so linear data can be brightened for display.
+		 * The channel order is left unchanged. Large images are split into row blocks that are converted in parallel.
+		 */
+		cv::Mat toEightBit(cv::Mat const& image, double gamma = 1.0);
+
+		///Converts an 8 bit image to four channels with premultiplied alpha, the layout of \c QImage::Format_ARGB32_Premultiplied.
+		/**
+		 * Qt paints this format without converting it first, which the three channel and greyscale formats
+		 * require on every paint event. Opaque images get an alpha of 255. The result takes a third more
+		 * memory than a three channel image and four times as much as a greyscale one.
+		 */
+		cv::Mat toPremultipliedBgra(cv::Mat const& image);
+
+	}
+
+}
\ No newline at end of file
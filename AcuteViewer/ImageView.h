@@ -1,281 +1,384 @@
-﻿#pragma once
-
-//Qt
-#include <QtWidgets/QtWidgets>
-#include <QtGui/QtGui>
-
-//OpenCv
-#include <opencv2/core.hpp>
-#include <opencv2/imgproc.hpp>
-#include <opencv2/core/ocl.hpp>
-
-//STL libraries
-#include <vector>
-#include <iostream>
-#include <cmath>
-#include <set>
-#include <functional>
-
-namespace hb {
-
-	///A class for displaying images.
-	/**
-	 * The \c ImageView can display an image and allows the user can zoom and pan.
-	 * Apart from that it supports adding and manipulation of points (e.g. reference points),
-	 * overlay painting (e.g. a mask), overlay of a mask as well as overlay and manipulation
-	 * of a polyline (e.g. a border).
-	 */
-	class ImageView : public QWidget {
-		Q_OBJECT
-	public:
-		ImageView(QWidget *parent = 0);
-		QSize sizeHint() const;
-
-		void setShowInterfaceOutline(bool value);
-		bool getShowInterfaceOutline();
-		void setInterfaceBackgroundColor(QColor const& color);
-		QColor const& getInterfaceBackgroundColor();
-		void setRightClickForHundredPercentView(bool value);
-		bool getRightClickForHundredPercentView();
-		void setUsePanZooming(bool value);
-		bool getUsesPanZooming();
-		void setUseGpu(bool value);
-		bool getUseGpu();
-		bool OpenClAvailable();
-
-		void rotateLeft();
-		void rotateRight();
-		void setRotation(double degrees);
-		void rotateBy(double degrees);
-		double getRotation() const;
-		void centerViewportOn(QPointF point);
-		void setPreventMagnificationInDefaultZoom(bool value);
-
-		void setImage(const QImage& image);
-		void setImage(QImage&& image);
-		void setImage(const cv::Mat& image);
-		void setImageWithPrecomputedPreview(const cv::Mat& image, const cv::Mat& downscaledImage);
-		void resetImage();
-		bool getImageAssigned() const;
-		QPointF mapToImageCoordinates(QPointF pointInWidgetCoordinates) const;
-
-		double getCurrentPreviewScalingFactor() const;
-		void setUseHighQualityDownscaling(bool value);
-		bool getUseHighQualityDownscaling();
-		void setUseSmoothTransform(bool value);
-		bool getUseSmoothTransform() const;
-		void setEnablePostResizeSharpening(bool value);
-		bool getEnablePostResizeSharpening();
-		void setPostResizeSharpeningStrength(double value);
-		double getPostResizeSharpeningStrength();
-		void setPostResizeSharpeningRadius(double value);
-		double getPostResizeSharpeningRadius();
-		void setPostResizeSharpening(bool enable, double strength, double radius);
-
-		void setPointEditing(bool enablePointAdding, bool enablePointManipulation);
-		void setRenderPoints(bool value);
-		const std::vector<QPointF>& getPoints() const;
-		void setPoints(const std::vector<QPointF>& points);
-		void setPoints(std::vector<QPointF>&& points);
-		void addPoint(const QPointF& point);
-		void deleteOutsidePoints();
-
-		void setPaintingActive(bool value);
-		void setVisualizeBrushSize(bool value);
-		const QBitmap& getMask() const;
-		void setOverlayMask(const QBitmap& mask);
-		void setOverlayMask(QBitmap&& mask);
-		void setRenderOverlayMask(bool value);
-
-		void setRenderRectangle(bool value);
-		void setRectangle(QRectF rectangle);
-
-		void setRenderPolyline(bool value);
-		void setPolyline(std::vector<QPointF> border);
-		//if this is activated it will disable point adding
-		void setPolylineEditingActive(bool value);
-		const std::vector<QPointF>& getPolyline() const;
-		void setPolylineColor(QColor color);
-
-		template <typename T>
-		void setExternalPostPaintFunction(T* object, void(T::*function)(QPainter&));
-		void setExternalPostPaintFunction(std::function<void(QPainter&)> const& function);
-		void removeExternalPostPaintFunction();
-	public slots:
-		void zoomInKey();
-		void zoomOutKey();
-		void zoomToHundredPercent(QPointF center = QPointF());
-		void resetZoom();
-		void resetMask();
-		void setBrushRadius(int value);
-		void deletePoint(int index);
-		void resetPoints();
-		void invertPolylineColor();
-	protected:
-		void showEvent(QShowEvent * e);
-		void mousePressEvent(QMouseEvent* e);
-		void mouseMoveEvent(QMouseEvent* e);
-		void mouseReleaseEvent(QMouseEvent* e);
-		void mouseDoubleClickEvent(QMouseEvent* e);
-		void wheelEvent(QWheelEvent* e);
-		void resizeEvent(QResizeEvent* e);
-		void enterEvent(QEvent* e);
-		void leaveEvent(QEvent* e);
-		void paintEvent(QPaintEvent* e);
-		void keyPressEvent(QKeyEvent * e);
-		bool eventFilter(QObject *object, QEvent *e);
-	private:
-		double getEffectiveImageWidth() const;
-		double getEffectiveImageHeight() const;
-		double getWindowScalingFactor() const;
-		QTransform getTransform() const;
-		QTransform getTransformDownsampledImage() const;
-		QTransform getTransformScaleRotateOnly() const;
-		QTransform getTransformScaleOnly() const;
-		QTransform getTransformRotateOnly() const;
-		void zoomBy(double delta, QPointF const& center);
-		void enforcePanConstraints();
-		void updateResizedImage();
-
-		static double distance(const QPointF& point1, const QPointF& point2);
-		struct IndexWithDistance {
-			IndexWithDistance(int index, double distance) : index(index), distance(distance) { };
-			int index;
-			double distance;
-		};
-		IndexWithDistance closestGrabbablePoint(QPointF const& mousePosition) const;
-		IndexWithDistance closestGrabbablePolylinePoint(QPointF const& mousePosition) const;
-		double smallestDistanceToPolyline(QPointF const& mousePosition) const;
-		double smallestDistanceToPolylineSelection(QPointF const& mousePosition) const;
-		static double distanceOfPointToLineSegment(QPointF const& lineStart, QPointF const& lineEnd, QPointF const& point);
-
-		static void sharpen(cv::Mat& image, double strength, double radius);
-		static void sharpen(cv::UMat& image, double strength, double radius);
-
-		bool isConvertible(QImage::Format);
-		static void shallowCopyMatToImage(const cv::Mat& mat, QImage& destImage);
-		static void deepCopyMatToImage(const cv::Mat& mat, QImage& destImage);
-		static void shallowCopyImageToMat(const QImage& image, cv::Mat& destMat);
-		static void deepCopyImageToMat(const QImage& image, cv::Mat& destMat);
-		static void matToImage(const cv::Mat& mat, QImage& destImage, bool deepCopy);
-		static void imageToMat(const QImage& image, cv::Mat& destMat, bool deepCopy);
-
-		//related to general interface settings
-		bool interfaceOutline;
-		QColor backgroundColor;
-		bool rightClickForHundredPercentView;
-		bool usePanZooming;
-		bool useGpu = true;
-		//the users transformations (panning, zooming)
-		double zoomExponent;
-		const double zoomBasis;
-		bool preventMagnificationInDefaultZoom;
-		bool hundredPercentZoomMode;
-		QPointF panOffset;
-		double viewRotation;
-		//related to general click and drag events
-		bool dragging;
-		QPointF lastMousePosition;
-		int screenId;
-		bool moved;
-		//related to pan-zooming
-		bool panZooming;
-		QPointF initialMousePosition;
-		QPointF infinitePanLastInitialMousePosition;
-		double panZoomingInitialZoomExponent;
-		QPointF panZoomingInitialPanOffset;
-		//related to setting points and rendering them
-		std::vector<QPointF> points;
-		bool pointEditingActive;
-		bool pointManipulationActive;
-		bool renderPoints;
-		//related to editing of points
-		double pointGrabTolerance;
-		bool pointGrabbed;
-		int grabbedPointIndex;
-		bool showPointDeletionWarning;
-		//related to displaying the image
-		QImage image;
-		cv::Mat mat;
-		cv::UMat uMat;
-		bool isMat = false;
-		bool hasMat = false;
-		bool hasUmat = false;
-		QImage downsampledImage;
-		cv::Mat downsampledMat;
-		cv::UMat downsampledUmat;
-		bool imageAssigned;
-		bool useHighQualityDownscaling;
-		bool useSmoothTransform;
-		bool enablePostResizeSharpening;
-		double postResizeSharpeningStrength;
-		double postResizeSharpeningRadius;
-		//related to mask painting
-		QBitmap mask;
-		bool paintingActive;
-		bool maskInitialized;
-		bool painting;
-		double brushRadius;
-		QPointF brushPosition;
-		bool visualizeBrushSize;
-		//related to overlaying a mask
-		QBitmap overlayMask;
-		bool overlayMaskSet;
-		bool renderOverlayMask;
-		//related to painting rectangle
-		QRectF rectangle;
-		bool renderRectangle;
-		//related to displaying a polyline
-		std::vector<QPointF> polyline;
-		bool polylineAssigned;
-		bool renderPolyline;
-		//related to editing the polyline
-		bool polylineManipulationActive;
-		bool polylinePointGrabbed;
-		std::set<int> polylineSelectedPoints;
-		double polylinePointGrabTolerance;
-		bool polylineSelected;
-		int polylineLastAddedPoint;
-		QRectF selectionRectangle;
-		std::set<int> selectionRectanglePoints;
-		bool spanningSelectionRectangle;
-		QColor polylineColor;
-		//related to external post paint function
-		std::function<void(QPainter&)> externalPostPaint;
-		bool externalPostPaintFunctionAssigned;
-	signals:
-		///Emitted when a point is moved, emitted live during interaction (not just on mouse release).
-		void pointModified();
-		///Emitted when the user deletes a point, \p index specifies the index of the point that was deleted.
-		void userDeletedPoint(int index);
-		///Emitted when the user clicks somewhere where the click is not handled internally.
-		/**
-		 * A click is when the mouse is not moved inbetween a mouse press event and a mouse release
-		 * event. Some of the internal features of the \c image view use clicks for certain actions.
-		 * However, not every click might trigger internal procedures. If certain interaction features
-		 * are disabled this is most likely. In this case this signal is emitted. It can be connected
-		 * to a slot that then handles the occurence.
-		 */
-		void pixelClicked(QPoint pixel);
-		///Emitted when the polyline was modified, not emitted live during interaction but on mouse release.
-		void polylineModified();
-	};
-
-
-//=============================================================== IMPLEMENTATION OF TEMPLATE FUNCTIONS ===============================================================\\
-
-	///Registers a member function \p function of an \p object that will be called at the end of the \c paintEvent method.
-	/**
-	* This method can be used to register the member function of an object as post-paint function.
-	* The corresponding function will be called at the end of the \c paintEvent method.
-	* To that function the current widget is passed as a \c QPainter object which enables custom
-	* drawing on top of the widget, e.g. to display additional information.
-	*/
-	//template function, thus implemented in header
-	template <typename T>
-	void ImageView::setExternalPostPaintFunction(T* object, void(T::*function)(QPainter&)) {
-		this->externalPostPaint = std::bind(function, object, std::placeholders::_1);
-		this->externalPostPaintFunctionAssigned = true;
-	}
-
+﻿#pragma once
+
+//Qt
+#include <QtWidgets/QtWidgets>
+#include <QtGui/QtGui>
+
+//OpenCv
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/core/ocl.hpp>
+
+//STL libraries
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include <set>
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+#include <atomic>
+
+#include "WorkerPool.h"
+#include "TileSource.h"
+#include "DeviceImageCache.h"
+
+namespace hb {
+
+	///A class for displaying images.
+	/**
+	 * The \c ImageView can display an image and allows the user can zoom and pan.
+	 * Apart from that it supports adding and manipulation of points (e.g. reference points),
+	 * overlay painting (e.g. a mask), overlay of a mask as well as overlay and manipulation
+	 * of a polyline (e.g. a border).
+	 */
+	class ImageView : public QWidget {
+		Q_OBJECT
+	public:
+		///Image operations the view leaves to the application so it can use its own implementations; unset ones fall back to OpenCV.
+		struct ImageOperations {
+			//scales the source to the given size with area interpolation
+			std::function<void(cv::Mat const& source, cv::Mat& destination, cv::Size const& size)> resize;
+			//downscales and sharpens in one pass; returns false if it cannot, the view then resizes and sharpens separately
+			std::function<bool(cv::Mat const& source, cv::Mat& destination, cv::Size const& size, double strength, double radius, bool premultipliedAlpha)> resizeSharpened;
+			//converts an 8 bit image to premultiplied BGRA, returns an empty mat if it cannot
+			std::function<cv::Mat(cv::Mat const& image)> toPremultipliedBgra;
+		};
+
+		ImageView(QWidget *parent, std::shared_ptr<WorkerPool> workerPool, ImageOperations const& operations = ImageOperations());
+		~ImageView();
+		QSize sizeHint() const;
+
+		void setShowInterfaceOutline(bool value);
+		bool getShowInterfaceOutline();
+		void setInterfaceBackgroundColor(QColor const& color);
+		QColor const& getInterfaceBackgroundColor();
+		void setRightClickForHundredPercentView(bool value);
+		bool getRightClickForHundredPercentView();
+		void setUsePanZooming(bool value);
+		bool getUsesPanZooming();
+		void setUseGpu(bool value);
+		bool getUseGpu();
+		bool OpenClAvailable();
+
+		void rotateLeft();
+		void rotateRight();
+		void setRotation(double degrees);
+		void rotateBy(double degrees);
+		double getRotation() const;
+		void centerViewportOn(QPointF point);
+		void setPreventMagnificationInDefaultZoom(bool value);
+
+		void setImage(const QImage& image);
+		void setImage(QImage&& image);
+		void setImage(const cv::Mat& image, double pixelScale = 1, bool premultipliedAlpha = false);
+		void replaceImage(const cv::Mat& image, double pixelScale = 1, bool premultipliedAlpha = false);
+		void setTileSource(std::shared_ptr<TileSource> source);
+		void setImageWithPrecomputedPreview(const cv::Mat& image, const cv::Mat& downscaledImage);
+		void resetImage();
+		bool getImageAssigned() const;
+		double getImagePixelScale() const;
+		QPointF mapToImageCoordinates(QPointF pointInWidgetCoordinates) const;
+
+		double getCurrentPreviewScalingFactor() const;
+		void setUseHighQualityDownscaling(bool value);
+		bool getUseHighQualityDownscaling();
+		void setUseSmoothTransform(bool value);
+		bool getUseSmoothTransform() const;
+		void setEnablePostResizeSharpening(bool value);
+		bool getEnablePostResizeSharpening();
+		void setPostResizeSharpeningStrength(double value);
+		double getPostResizeSharpeningStrength();
+		void setPostResizeSharpeningRadius(double value);
+		double getPostResizeSharpeningRadius();
+		void setPostResizeSharpening(bool enable, double strength, double radius);
+
+		void setPointEditing(bool enablePointAdding, bool enablePointManipulation);
+		void setRenderPoints(bool value);
+		const std::vector<QPointF>& getPoints() const;
+		void setPoints(const std::vector<QPointF>& points);
+		void setPoints(std::vector<QPointF>&& points);
+		void addPoint(const QPointF& point);
+		void deleteOutsidePoints();
+
+		void setPaintingActive(bool value);
+		void setVisualizeBrushSize(bool value);
+		const QBitmap& getMask() const;
+		void setOverlayMask(const QBitmap& mask);
+		void setOverlayMask(QBitmap&& mask);
+		void setRenderOverlayMask(bool value);
+
+		void setRenderRectangle(bool value);
+		void setRectangle(QRectF rectangle);
+
+		void setRenderPolyline(bool value);
+		void setPolyline(std::vector<QPointF> border);
+		//if this is activated it will disable point adding
+		void setPolylineEditingActive(bool value);
+		const std::vector<QPointF>& getPolyline() const;
+		void setPolylineColor(QColor color);
+
+		template <typename T>
+		void setExternalPostPaintFunction(T* object, void(T::*function)(QPainter&));
+		void setExternalPostPaintFunction(std::function<void(QPainter&)> const& function);
+		void removeExternalPostPaintFunction();
+	public slots:
+		void zoomInKey();
+		void zoomOutKey();
+		void zoomToHundredPercent(QPointF center = QPointF());
+		void resetZoom();
+		void resetMask();
+		void setBrushRadius(int value);
+		void deletePoint(int index);
+		void resetPoints();
+		void invertPolylineColor();
+	protected:
+		void showEvent(QShowEvent * e);
+		void mousePressEvent(QMouseEvent* e);
+		void mouseMoveEvent(QMouseEvent* e);
+		void mouseReleaseEvent(QMouseEvent* e);
+		void mouseDoubleClickEvent(QMouseEvent* e);
+		void wheelEvent(QWheelEvent* e);
+		void resizeEvent(QResizeEvent* e);
+		void enterEvent(QEvent* e);
+		void leaveEvent(QEvent* e);
+		void paintEvent(QPaintEvent* e);
+		void keyPressEvent(QKeyEvent * e);
+		bool eventFilter(QObject *object, QEvent *e);
+	private:
+		double getEffectiveImageWidth() const;
+		double getEffectiveImageHeight() const;
+		double getWindowScalingFactor() const;
+		QTransform getTransform() const;
+		QTransform getTransformDownsampledImage() const;
+		QTransform getTransformScaleRotateOnly() const;
+		QTransform getTransformScaleOnly() const;
+		QTransform getTransformRotateOnly() const;
+		void zoomBy(double delta, QPointF const& center);
+		void enforcePanConstraints();
+		void updateResizedImage();
+		void invalidateDerivedImages();
+		void addPyramidLevel(unsigned int generation, cv::Mat const& level);
+		int pyramidLevelFor(cv::Size const& targetSize) const;
+		void applyResizedImage(unsigned int requestId, double scalingFactor, cv::Mat const& resizedMat, QImage const& resizedImage);
+
+		//everything a downscale on a worker thread needs, copied so the members may change while it runs
+		struct ResizeRequest {
+			unsigned int id;
+			double scalingFactor;
+			cv::Size targetSize;
+			//the pyramid level or full image to resize from; for images that are no mats, sourceImage is used instead
+			cv::Mat source;
+			//whether the resize may run on the GPU; the device copy of the image is looked up by generation
+			bool deviceAllowed = false;
+			unsigned int generation = 0;
+			//also keeps the pixels alive if source wraps them
+			QImage sourceImage;
+			bool hasMat;
+			bool sharpen;
+			double sharpeningStrength;
+			double sharpeningRadius;
+			bool premultipliedAlpha;
+		};
+		void performResize(ResizeRequest const& request, cv::Mat& resizedMat, QImage& resizedImage);
+		void paintTiles(QPainter& canvas, QTransform const& transform);
+		void paintSourceTiles(QPainter& canvas, QTransform const& transform, double scalingFactor);
+		QRect visibleTiles(QTransform const& transform, QSize const& imageSize, QSize const& tileSize) const;
+		static quint64 tileKey(int level, int column, int row);
+		void requestTile(int column, int row);
+		void requestSourceTile(int level, int column, int row);
+		void addTile(unsigned int generation, quint64 key, QImage const& tile);
+		void dropTileRequestsOutside(int level, QRect const& tiles);
+		void cancelTileRequests();
+		void abandonTask(WorkerPool::TaskHandle const& task);
+		QRect paddedTileArea(QRect const& area) const;
+		QImage convertTile(cv::Mat const& source, QImage const& sourceImage, bool hasMat, bool premultipliedAlpha, QRect const& area) const;
+		static cv::Mat premultipliedBgra(cv::Mat const& image);
+
+		static double distance(const QPointF& point1, const QPointF& point2);
+		struct IndexWithDistance {
+			IndexWithDistance(int index, double distance) : index(index), distance(distance) { };
+			int index;
+			double distance;
+		};
+		IndexWithDistance closestGrabbablePoint(QPointF const& mousePosition) const;
+		IndexWithDistance closestGrabbablePolylinePoint(QPointF const& mousePosition) const;
+		double smallestDistanceToPolyline(QPointF const& mousePosition) const;
+		double smallestDistanceToPolylineSelection(QPointF const& mousePosition) const;
+		static double distanceOfPointToLineSegment(QPointF const& lineStart, QPointF const& lineEnd, QPointF const& point);
+
+		static void sharpen(cv::Mat& image, double strength, double radius);
+		static void sharpen(cv::UMat& image, double strength, double radius);
+		static void clampToAlpha(cv::Mat& image);
+
+		bool isConvertible(QImage::Format);
+		static void shallowCopyMatToImage(const cv::Mat& mat, QImage& destImage, bool premultipliedAlpha = false);
+		static void deepCopyMatToImage(const cv::Mat& mat, QImage& destImage, bool premultipliedAlpha = false);
+		static void shallowCopyImageToMat(const QImage& image, cv::Mat& destMat);
+		static void deepCopyImageToMat(const QImage& image, cv::Mat& destMat);
+		static void matToImage(const cv::Mat& mat, QImage& destImage, bool deepCopy, bool premultipliedAlpha = false);
+		static void imageToMat(const QImage& image, cv::Mat& destMat, bool deepCopy);
+
+		//related to general interface settings
+		bool interfaceOutline;
+		QColor backgroundColor;
+		bool rightClickForHundredPercentView;
+		bool usePanZooming;
+		bool useGpu = true;
+		//the users transformations (panning, zooming)
+		double zoomExponent;
+		const double zoomBasis;
+		bool preventMagnificationInDefaultZoom;
+		bool hundredPercentZoomMode;
+		QPointF panOffset;
+		double viewRotation;
+		//related to general click and drag events
+		bool dragging;
+		QPointF lastMousePosition;
+		int screenId;
+		bool moved;
+		//related to pan-zooming
+		bool panZooming;
+		QPointF initialMousePosition;
+		QPointF infinitePanLastInitialMousePosition;
+		double panZoomingInitialZoomExponent;
+		QPointF panZoomingInitialPanOffset;
+		//related to setting points and rendering them
+		std::vector<QPointF> points;
+		bool pointEditingActive;
+		bool pointManipulationActive;
+		bool renderPoints;
+		//related to editing of points
+		double pointGrabTolerance;
+		bool pointGrabbed;
+		int grabbedPointIndex;
+		bool showPointDeletionWarning;
+		//related to displaying the image
+		QImage image;
+		cv::Mat mat;
+		bool isMat = false;
+		bool hasMat = false;
+		//device copies of the image, uploaded only when a downscale on the GPU is expected to pay off
+		DeviceImageCache deviceImages;
+		QImage downsampledImage;
+		cv::Mat downsampledMat;
+		//the scaling factor downsampledImage was computed for; while a newer one is computed it is drawn stretched
+		double downsampledScalingFactor = 0;
+		//only the result of the newest downscale request is shown, older ones are dropped
+		std::atomic<unsigned int> latestResizeRequest{ 0 };
+		WorkerPool::TaskHandle resizeTask;
+		bool imageAssigned;
+		//how many pixels of the original image one pixel of the assigned image corresponds to, e.g. 4 for a reduced decode
+		double imagePixelScale = 1;
+		//the colour channels of a four channel mat are premultiplied by alpha, which Qt can paint without converting
+		bool matIsPremultiplied = false;
+		//successively halved copies of mat, built in the background so zooming only has to resize a nearby level
+		std::vector<cv::Mat> pyramid;
+		//incremented whenever the image changes, so levels of a previous image are discarded
+		unsigned int imageGeneration = 0;
+		std::shared_ptr<std::atomic<bool>> pyramidCancellation;
+		//no levels are built below this size, resizing from the image itself is cheap enough there
+		static constexpr int minimumPyramidLevelSize = 512;
+		//tiles of the image in a format Qt can paint directly; when zoomed in only the visible ones are drawn
+		QCache<quint64, QImage> tileCache;
+		struct TileRequest {
+			int level;
+			int column;
+			int row;
+			WorkerPool::TaskHandle task;
+		};
+		QHash<quint64, TileRequest> pendingTiles;
+		//incremented whenever the cached tiles become invalid, so tiles that were still being read are discarded
+		unsigned int tileGeneration = 0;
+		//provides the pixels beyond the resolution of the assigned image, which then only serves as an overview
+		std::shared_ptr<TileSource> tileSource;
+		static constexpr int tileSize = 256;
+		//tiles are converted with this many pixels of their neighbours, without them smooth interpolation would show seams
+		static constexpr int tileOverlap = 1;
+		//smaller images are drawn in one piece, the overhead of tiling does not pay off there
+		static constexpr qint64 minimumTiledImageSize = 4096 * 4096;
+		static constexpr qint64 tileCacheSize = 128 * 1024 * 1024;
+		//up to this size a two-dimensional unsharp kernel on the device is cheaper than blurring and masking in separate passes; the fused CPU path stops at the same size
+		static constexpr int maximumFusedSharpeningKernelSize = 11;
+		std::shared_ptr<WorkerPool> workerPool;
+		ImageOperations operations;
+		//tasks that could not be cancelled because they were already running; they refer to this object, so it waits for them on destruction
+		QVector<WorkerPool::TaskHandle> abandonedTasks;
+		WorkerPool::TaskHandle pyramidTask;
+		bool useHighQualityDownscaling;
+		bool useSmoothTransform;
+		bool enablePostResizeSharpening;
+		double postResizeSharpeningStrength;
+		double postResizeSharpeningRadius;
+		//related to mask painting
+		QBitmap mask;
+		bool paintingActive;
+		bool maskInitialized;
+		bool painting;
+		double brushRadius;
+		QPointF brushPosition;
+		bool visualizeBrushSize;
+		//related to overlaying a mask
+		QBitmap overlayMask;
+		bool overlayMaskSet;
+		bool renderOverlayMask;
+		//related to painting rectangle
+		QRectF rectangle;
+		bool renderRectangle;
+		//related to displaying a polyline
+		std::vector<QPointF> polyline;
+		bool polylineAssigned;
+		bool renderPolyline;
+		//related to editing the polyline
+		bool polylineManipulationActive;
+		bool polylinePointGrabbed;
+		std::set<int> polylineSelectedPoints;
+		double polylinePointGrabTolerance;
+		bool polylineSelected;
+		int polylineLastAddedPoint;
+		QRectF selectionRectangle;
+		std::set<int> selectionRectanglePoints;
+		bool spanningSelectionRectangle;
+		QColor polylineColor;
+		//related to external post paint function
+		std::function<void(QPainter&)> externalPostPaint;
+		bool externalPostPaintFunctionAssigned;
+	signals:
+		///Emitted when a point is moved, emitted live during interaction (not just on mouse release).
+		void pointModified();
+		///Emitted when the user deletes a point, \p index specifies the index of the point that was deleted.
+		void userDeletedPoint(int index);
+		///Emitted when the user clicks somewhere where the click is not handled internally.
+		/**
+		 * A click is when the mouse is not moved inbetween a mouse press event and a mouse release
+		 * event. Some of the internal features of the \c image view use clicks for certain actions.
+		 * However, not every click might trigger internal procedures. If certain interaction features
+		 * are disabled this is most likely. In this case this signal is emitted. It can be connected
+		 * to a slot that then handles the occurence.
+		 */
+		void pixelClicked(QPoint pixel);
+		///Emitted when the polyline was modified, not emitted live during interaction but on mouse release.
+		void polylineModified();
+		///Emitted when the magnification at which the image is displayed may have changed, e.g. through zooming, rotating or resizing.
+		void magnificationChanged();
+	};
+
+
+//=============================================================== IMPLEMENTATION OF TEMPLATE FUNCTIONS ===============================================================\\
+
+	///Registers a member function \p function of an \p object that will be called at the end of the \c paintEvent method.
+	/**
+	* This method can be used to register the member function of an object as post-paint function.
+	* The corresponding function will be called at the end of the \c paintEvent method.
+	* To that function the current widget is passed as a \c QPainter object which enables custom
+	* drawing on top of the widget, e.g. to display additional information.
+	*/
+	//template function, thus implemented in header
+	template <typename T>
+	void ImageView::setExternalPostPaintFunction(T* object, void(T::*function)(QPainter&)) {
+		this->externalPostPaint = std::bind(function, object, std::placeholders::_1);
+		this->externalPostPaintFunctionAssigned = true;
+	}
+
 }
\ No newline at end of file
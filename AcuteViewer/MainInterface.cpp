@@ -1,1653 +1,2120 @@
-#include "MainInterface.h"
-#ifdef Q_OS_WIN
-#include <shellapi.h>
-#endif
-
-namespace sv {
-
-	Image::Image() { }
-
-	Image::Image(cv::Mat mat, std::shared_ptr<ExifData> exifData, bool isPreviewImage) : matrix(mat), exifData(exifData), valid(true), previewImage(isPreviewImage) { }
-
-	cv::Mat Image::mat() const {
-		return matrix;
-	}
-
-	std::shared_ptr<ExifData> Image::exif() const {
-		return exifData;
-	}
-
-	bool Image::isValid() const {
-		return valid;
-	}
-
-	bool Image::isPreviewImage() const {
-		return previewImage;
-	}
-
-	//============================================================================ MAIN INTERFACE ============================================================================\\
-
-	MainInterface::MainInterface(QString openWithFilename, QWidget *parent)
-		: QMainWindow(parent),
-		settings(new QSettings(QSettings::IniFormat, QSettings::UserScope, "Acute Viewer", "Acute Viewer")) {
-
-		initialize();
-
-		if (openWithFilename != QString()) {
-			loadImage(openWithFilename);
-		}
-	}
-
-	MainInterface::MainInterface(QStringList openWithFilenames, QWidget * parent) 
-		: QMainWindow(parent),
-		settings(new QSettings(QSettings::IniFormat, QSettings::UserScope, "Acute Viewer", "Acute Viewer")) {
-
-		initialize();
-		
-		loadImages(openWithFilenames);
-	}
-
-	MainInterface::~MainInterface() {
-		delete imageView;
-		delete slideshowDialog;
-		delete sharpeningDialog;
-		delete fileMenu;
-		delete viewMenu;
-		delete slideshowMenu;
-		delete applicationMenu;
-		delete quitAction;
-		delete openAction;
-		delete refreshAction;
-		delete resetSettingsAction;
-		delete showInfoAction;
-		delete smoothingAction;
-		delete enlargementAction;
-		delete sharpeningAction;
-		delete sharpeningOptionsAction;
-		delete menuBarAutoHideAction;
-		delete slideshowAction;
-		delete slideshowNoDialogAction;
-		delete zoomLevelAction;
-		delete installAction;
-		delete uninstallAction;
-		delete mouseHideTimer;
-		delete threadCleanUpTimer;
-		delete slideshowTimer;
-	}
-
-	QSize MainInterface::sizeHint() const {
-		return settings->value("windowSize", QSize(900, 600)).toSize();
-		//return QSize(900, 600);
-	}
-
-	//============================================================================== PROTECTED ==============================================================================\\
-
-	bool MainInterface::eventFilter(QObject* object, QEvent* e) {
-		if (e->type() == QEvent::MouseButtonRelease) {
-			QMouseEvent* keyEvent = (QMouseEvent*)e;
-			mouseReleaseEvent(keyEvent);
-		} else if (e->type() == QEvent::Wheel) {
-			if (menuBar()->isVisible()) {
-				hideMenuBar();
-			}
-		} else if (e->type() == QEvent::MouseMove) {
-			QMouseEvent* keyEvent = (QMouseEvent*)e;
-			mouseMoveEvent(keyEvent);
-		}
-		return false;
-	}
-
-	void MainInterface::dragEnterEvent(QDragEnterEvent* e) {
-		if (e->mimeData()->hasUrls()) {
-			if (!e->mimeData()->urls().isEmpty() && QFileInfo(e->mimeData()->urls().first().toLocalFile()).isFile()) {
-				e->acceptProposedAction();
-			}
-		}
-	}
-
-	void MainInterface::dropEvent(QDropEvent* e) {
-		if (!e->mimeData()->urls().isEmpty()) {
-			if (e->mimeData()->urls().size() == 1) {
-				QString path = e->mimeData()->urls().first().toLocalFile();
-				loadImage(path);
-			} else {
-				QStringList paths;
-				for (QUrl& url : e->mimeData()->urls()) {
-					paths.append(url.toLocalFile());
-				}
-				loadImages(paths);
-			}
-		}
-	}
-
-	void MainInterface::keyPressEvent(QKeyEvent* e) {
-		if (e->modifiers() == (Qt::ControlModifier | Qt::ShiftModifier)) {
-			if (e->key() == Qt::Key_Right) {
-				changeFontSizeBy(1);
-				e->accept();
-			} else if (e->key() == Qt::Key_Left) {
-				changeFontSizeBy(-1);
-				e->accept();
-			} else if (e->key() == Qt::Key_Up) {
-				changeLineSpacingBy(1);
-				e->accept();
-			} else if (e->key() == Qt::Key_Down) {
-				changeLineSpacingBy(-1);
-				e->accept();
-			}
-		} else if (e->key() == Qt::Key_Right || e->key() == Qt::Key_Down) {
-			loadNextImage();
-			e->accept();
-		} else if (e->key() == Qt::Key_Left || e->key() == Qt::Key_Up) {
-			loadPreviousImage();
-			e->accept();
-		} else if (e->key() == Qt::Key_Escape) {
-			if (menuBar()->isVisible()) {
-				hideMenuBar();
-			} else if (isFullScreen()) {
-				exitFullscreen();
-			}
-		} else {
-			e->ignore();
-		}
-	}
-
-	void MainInterface::keyReleaseEvent(QKeyEvent* e) {
-		if (e->key() == Qt::Key_Alt && !skipNextAltRelease) {
-			if (!menuBar()->isVisible()){
-				showMenuBar();
-				e->accept();
-			} else {
-				hideMenuBar();
-				e->ignore();
-			}
-		}
-		if (e->key() == Qt::Key_Alt) {
-			skipNextAltRelease = false;
-		}
-	}
-
-	void MainInterface::mouseDoubleClickEvent(QMouseEvent* e) {
-		if (e->button() == Qt::LeftButton) {
-			toggleFullscreen();
-			e->accept();
-		}
-	}
-
-	void MainInterface::mouseReleaseEvent(QMouseEvent* e) {
-		if (e->button() == Qt::ForwardButton) loadNextImage();
-		if (e->button() == Qt::BackButton) loadPreviousImage();
-		if (menuBar()->isVisible()) {
-			hideMenuBar();
-		}
-	}
-
-	void MainInterface::mouseMoveEvent(QMouseEvent* e) {
-		if (isFullScreen()) {
-			showMouse();
-			enableAutomaticMouseHide();
-		}
-		e->ignore();
-	}
-
-	void MainInterface::changeEvent(QEvent* e) {
-		if (e->type() == QEvent::WindowStateChange) {
-			if (!isMinimized() && !isFullScreen()) {
-				settings->setValue("maximized", isMaximized());
-				saveSizeAction->setEnabled(!isMaximized());
-			} else if (isFullScreen()) {
-				QWindowStateChangeEvent* windowStateChangeEvent = static_cast<QWindowStateChangeEvent*>(e);
-				settings->setValue("maximized", bool(windowStateChangeEvent->oldState() & Qt::WindowMaximized));
-				saveSizeAction->setEnabled(false);
-			}
-		}
-	}
-
-	void MainInterface::wheelEvent(QWheelEvent * e) {
-		if (e->modifiers() == Qt::ShiftModifier) {
-			if (e->angleDelta().y() > 0) {
-				userRotation -= 10;
-				imageView->rotateBy(-10);
-			} else if (e->angleDelta().y() < 0) {
-				userRotation += 10;
-				imageView->rotateBy(10);
-			}
-		}
-	}
-
-	//=============================================================================== PRIVATE ===============================================================================\\
-
-	void MainInterface::initialize() {
-		setAcceptDrops(true);
-		qRegisterMetaType<Image>("Image");
-		QObject::connect(this, SIGNAL(readImageFinished(Image)), this, SLOT(reactToReadImageCompletion(Image)));
-		setWindowTitle(programTitle);
-
-		imageView = new hb::ImageView(this);
-		imageView->setShowInterfaceOutline(false);
-		imageView->setUseSmoothTransform(false);
-		imageView->installEventFilter(this);
-		imageView->setExternalPostPaintFunction(this, &MainInterface::infoPaintFunction);
-		imageView->setInterfaceBackgroundColor(Qt::black);
-		imageView->setPreventMagnificationInDefaultZoom(true);
-		imageView->setUseGpu(true);
-		imageView->setPostResizeSharpening(false, settings->value("sharpeningStrength", 0.5).toDouble(), settings->value("sharpeningRadius", 0.5).toDouble());
-		setCentralWidget(imageView);
-
-		slideshowDialog = new SlideshowDialog(settings, this);
-		slideshowDialog->setWindowModality(Qt::WindowModal);
-		QObject::connect(slideshowDialog, &SlideshowDialog::accepted, this, &MainInterface::startSlideshow);
-		QObject::connect(slideshowDialog, SIGNAL(finished(int)), this, SLOT(enableAutomaticMouseHide()));
-
-		sharpeningDialog = new SharpeningDialog(settings, this);
-		QObject::connect(sharpeningDialog, SIGNAL(sharpeningParametersChanged()), this, SLOT(updateSharpening()));
-		QObject::connect(sharpeningDialog, SIGNAL(finished(int)), this, SLOT(enableAutomaticMouseHide()));
-
-		hotkeyDialog = new HotkeyDialog(settings, this);
-		hotkeyDialog->setWindowModality(Qt::WindowModal);
-		QObject::connect(hotkeyDialog, SIGNAL(finished(int)), this, SLOT(enableAutomaticMouseHide()));
-		QObject::connect(hotkeyDialog, SIGNAL(finished(int)), this, SLOT(updateCustomHotkeys()));
-
-		aboutDialog = new AboutDialog(settings, this);
-		aboutDialog->setWindowModality(Qt::WindowModal);
-
-		QObject::connect(menuBar(), SIGNAL(triggered(QAction*)), this, SLOT(hideMenuBar(QAction*)));
-		fileMenu = menuBar()->addMenu(tr("&File"));
-		viewMenu = menuBar()->addMenu(tr("&View"));
-		zoomMenu = menuBar()->addMenu(tr("&Zoom"));
-		rotationMenu = menuBar()->addMenu(tr("&Rotation"));
-		sharpeningMenu = menuBar()->addMenu(tr("&Sharpening"));
-		slideshowMenu = menuBar()->addMenu(tr("S&lideshow"));
-
-		applicationMenu = menuBar()->addMenu(tr("&Application"));
-#ifdef Q_OS_WIN
-		QObject::connect(applicationMenu, SIGNAL(aboutToShow()), this, SLOT(populateApplicationMenu()));
-		installAction = new QAction(tr("&Install"), this);
-		QObject::connect(installAction, SIGNAL(triggered()), this, SLOT(runInstaller()));
-		uninstallAction = new QAction(tr("&Uninstall"), this);
-		QObject::connect(uninstallAction, SIGNAL(triggered()), this, SLOT(runUninstaller()));
-#endif
-
-		aboutAction = new QAction(tr("&About"), this);
-		aboutAction->setShortcut(Qt::Key_F1);
-		aboutAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(aboutAction, SIGNAL(triggered()), aboutDialog, SLOT(show()));
-		applicationMenu->addAction(aboutAction);
-		addAction(aboutAction);
-
-		openAction = new QAction(tr("&Open File"), this);
-		openAction->setShortcut(QKeySequence::Open);
-		openAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(openAction, SIGNAL(triggered()), this, SLOT(openDialog()));
-		fileMenu->addAction(openAction);
-		addAction(openAction);
-
-		refreshAction = new QAction(tr("&Refresh"), this);
-		refreshAction->setEnabled(false);
-		refreshAction->setShortcut(Qt::Key_F5);
-		refreshAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(refreshAction, SIGNAL(triggered()), this, SLOT(refresh()));
-		fileMenu->addAction(refreshAction);
-		addAction(refreshAction);
-
-		fileMenu->addSeparator();
-
-		fileActionAction = new QAction(tr("&Enable File Action Hotkeys"), this);
-		fileActionAction->setCheckable(true);
-		fileActionAction->setChecked(false);
-		fileActionAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_H));
-		fileActionAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(fileActionAction, SIGNAL(triggered(bool)), hotkeyDialog, SLOT(setHotkeysEnabled(bool)));
-		fileMenu->addAction(fileActionAction);
-		addAction(fileActionAction);
-
-		hotkeyOptionsAction = new QAction(tr("&Hotkey Options..."), this);
-		hotkeyOptionsAction->setShortcut(QKeyCombination(Qt::CTRL | Qt::SHIFT, Qt::Key_O));
-		hotkeyOptionsAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(hotkeyOptionsAction, SIGNAL(triggered()), this, SLOT(showHotkeyDialog()));
-		fileMenu->addAction(hotkeyOptionsAction);
-		addAction(hotkeyOptionsAction);
-
-		fileMenu->addSeparator();
-
-		includePartiallySupportedFilesAction = new QAction(tr("&Include Preview-Only Files in Directory List"), this);
-		includePartiallySupportedFilesAction->setCheckable(true);
-		includePartiallySupportedFilesAction->setChecked(true);
-		includePartiallySupportedFilesAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_P));
-		includePartiallySupportedFilesAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(includePartiallySupportedFilesAction, SIGNAL(triggered(bool)), this, SLOT(togglePreviewOnlyFiles(bool)));
-		fileMenu->addAction(includePartiallySupportedFilesAction);
-		addAction(includePartiallySupportedFilesAction);
-
-		fileMenu->addSeparator();
-
-		resetSettingsAction = new QAction(tr("&Reset All Settings to Default"), this);
-		QObject::connect(resetSettingsAction, SIGNAL(triggered()), this, SLOT(resetSettings()));
-		fileMenu->addAction(resetSettingsAction);
-
-		fileMenu->addSeparator();
-
-		quitAction = new QAction(tr("&Quit"), this);
-		quitAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_Q));
-		quitAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(quitAction, SIGNAL(triggered()), this, SLOT(quit()));
-		fileMenu->addAction(quitAction);
-		//so shortcuts also work when menu bar is not visible
-		addAction(quitAction);
-
-		showInfoAction = new QAction(tr("Show &Info Overlay"), this);
-		showInfoAction->setCheckable(true);
-		showInfoAction->setChecked(false);
-		showInfoAction->setShortcut(Qt::Key_I);
-		showInfoAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(showInfoAction, SIGNAL(triggered(bool)), this, SLOT(toggleInfoOverlay(bool)));
-		viewMenu->addAction(showInfoAction);
-		addAction(showInfoAction);
-
-		zoomLevelAction = new QAction(tr("Show &Zoom Level Overlay"), this);
-		zoomLevelAction->setCheckable(true);
-		zoomLevelAction->setChecked(false);
-		zoomLevelAction->setShortcut(Qt::Key_Z);
-		zoomLevelAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(zoomLevelAction, SIGNAL(triggered(bool)), this, SLOT(toggleZoomLevelOverlay(bool)));
-		viewMenu->addAction(zoomLevelAction);
-		addAction(zoomLevelAction);
-
-		backgroundColorMenu = viewMenu->addMenu(tr("&Background Colour"));
-
-		backgroundColorBlackAction = new QAction(tr("&Black"), this);
-		backgroundColorBlackAction->setCheckable(true);
-		backgroundColorBlackAction->setChecked(false);
-		backgroundColorBlackAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_B));
-		backgroundColorBlackAction->setShortcutContext(Qt::ApplicationShortcut);
-		backgroundColorMenu->addAction(backgroundColorBlackAction);
-		addAction(backgroundColorBlackAction);
-
-		backgroundColorGrayAction = new QAction(tr("Dark &Grey"), this);
-		backgroundColorGrayAction->setCheckable(true);
-		backgroundColorGrayAction->setChecked(false);
-		backgroundColorGrayAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_G));
-		backgroundColorGrayAction->setShortcutContext(Qt::ApplicationShortcut);
-		backgroundColorMenu->addAction(backgroundColorGrayAction);
-		addAction(backgroundColorGrayAction);
-
-		backgroundColorWhiteAction = new QAction(tr("&White"), this);
-		backgroundColorWhiteAction->setCheckable(true);
-		backgroundColorWhiteAction->setChecked(false);
-		backgroundColorWhiteAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_W));
-		backgroundColorWhiteAction->setShortcutContext(Qt::ApplicationShortcut);
-		backgroundColorMenu->addAction(backgroundColorWhiteAction);
-		addAction(backgroundColorWhiteAction);
-
-		backgroundColorCustomAction = new QAction(tr("&Custom"), this);
-		backgroundColorCustomAction->setCheckable(true);
-		backgroundColorCustomAction->setChecked(false);
-		backgroundColorCustomAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_C));
-		backgroundColorCustomAction->setShortcutContext(Qt::ApplicationShortcut);
-		backgroundColorMenu->addAction(backgroundColorCustomAction);
-		addAction(backgroundColorCustomAction);
-
-		backgroundColorActionGroup = new QActionGroup(this);
-		backgroundColorActionGroup->addAction(backgroundColorBlackAction);
-		backgroundColorActionGroup->addAction(backgroundColorGrayAction);
-		backgroundColorActionGroup->addAction(backgroundColorWhiteAction);
-		backgroundColorActionGroup->addAction(backgroundColorCustomAction);
-		backgroundColorActionGroup->setExclusive(true);
-		QObject::connect(backgroundColorActionGroup, SIGNAL(triggered(QAction*)), this, SLOT(changeBackgroundColor(QAction*)));
-
-		viewMenu->addSeparator();
-
-		fullscreenAction = new QAction(tr("&Fullscreen"), this);
-		fullscreenAction->setCheckable(true);
-		fullscreenAction->setChecked(false);
-		fullscreenAction->setShortcut(Qt::Key_F);
-		fullscreenAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(fullscreenAction, SIGNAL(triggered(bool)), this, SLOT(toggleFullscreen()));
-		viewMenu->addAction(fullscreenAction);
-		addAction(fullscreenAction);
-
-		viewMenu->addSeparator();
-
-		menuBarAutoHideAction = new QAction(tr("&Always Show Menu Bar"), this);
-		menuBarAutoHideAction->setCheckable(true);
-		menuBarAutoHideAction->setChecked(false);
-		menuBarAutoHideAction->setShortcut(Qt::Key_M);
-		menuBarAutoHideAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(menuBarAutoHideAction, SIGNAL(triggered(bool)), this, SLOT(toggleMenuBarAutoHide(bool)));
-		viewMenu->addAction(menuBarAutoHideAction);
-		addAction(menuBarAutoHideAction);
-
-		viewMenu->addSeparator();
-
-		gpuAction = new QAction(tr("&Use GPU Acceleration"), this);
-		gpuAction->setCheckable(true);
-		gpuAction->setChecked(imageView->getUseGpu());
-		QObject::connect(gpuAction, SIGNAL(triggered(bool)), this, SLOT(toggleGpu(bool)));
-		viewMenu->addAction(gpuAction);
-
-		viewMenu->addSeparator();
-
-		saveSizeAction = new QAction(tr("&Save Current Window Size and Position as Default"), this);
-		QObject::connect(saveSizeAction, SIGNAL(triggered(bool)), this, SLOT(saveWindowSize()));
-		viewMenu->addAction(saveSizeAction);
-
-		enlargementAction = new QAction(tr("&Enlarge Smaller Images to Fit Window"), this);
-		enlargementAction->setCheckable(true);
-		enlargementAction->setChecked(false);
-		enlargementAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_U));
-		enlargementAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(enlargementAction, SIGNAL(triggered(bool)), this, SLOT(toggleSmallImageUpscaling(bool)));
-		zoomMenu->addAction(enlargementAction);
-		addAction(enlargementAction);
-
-		smoothingAction = new QAction(tr("Use &Smooth Interpolation when Enlarging"), this);
-		smoothingAction->setCheckable(true);
-		smoothingAction->setChecked(false);
-		smoothingAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_S));
-		smoothingAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(smoothingAction, SIGNAL(triggered(bool)), this, SLOT(toggleEnglargmentInterpolationMethod(bool)));
-		zoomMenu->addAction(smoothingAction);
-		addAction(smoothingAction);
-
-		zoomMenu->addSeparator();
-
-		zoomToFitAction = new QAction(tr("Zoom to &Fit"), this);
-		zoomToFitAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_0));
-		zoomToFitAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(zoomToFitAction, SIGNAL(triggered(bool)), imageView, SLOT(resetZoom()));
-		zoomMenu->addAction(zoomToFitAction);
-		addAction(zoomToFitAction);
-
-		zoomTo100Action = new QAction(tr("Zoom to &100%"), this);
-		zoomTo100Action->setShortcut(QKeyCombination(Qt::CTRL | Qt::ALT, Qt::Key_0));
-		zoomTo100Action->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(zoomTo100Action, SIGNAL(triggered(bool)), this, SLOT(zoomTo100()));
-		zoomMenu->addAction(zoomTo100Action);
-		addAction(zoomTo100Action);
-
-		rotateLeftAction = new QAction(tr("Rotate View &Left"), this);
-		rotateLeftAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_Left));
-		rotateLeftAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(rotateLeftAction, SIGNAL(triggered(bool)), this, SLOT(rotateLeft()));
-		rotationMenu->addAction(rotateLeftAction);
-		addAction(rotateLeftAction);
-
-		rotateRightAction = new QAction(tr("Rotate &View Right"), this);
-		rotateRightAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_Right));
-		rotateRightAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(rotateRightAction, SIGNAL(triggered(bool)), this, SLOT(rotateRight()));
-		rotationMenu->addAction(rotateRightAction);
-		addAction(rotateRightAction);
-
-		resetRotationAction = new QAction(tr("&Reset Rotation"), this);
-		resetRotationAction->setShortcut(QKeyCombination(Qt::SHIFT, Qt::Key_Escape));
-		resetRotationAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(resetRotationAction, SIGNAL(triggered(bool)), this, SLOT(resetRotation()));
-		rotationMenu->addAction(resetRotationAction);
-		addAction(resetRotationAction);
-
-		rotationMenu->addSeparator();
-
-		autoRotationAction = new QAction(tr("&Automatic EXIF-based rotation"), this);
-		autoRotationAction->setCheckable(true);
-		autoRotationAction->setChecked(true);
-		autoRotationAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_R));
-		autoRotationAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(autoRotationAction, SIGNAL(triggered(bool)), this, SLOT(toggleAutoRotation(bool)));
-		rotationMenu->addAction(autoRotationAction);
-		addAction(autoRotationAction);
-
-		sharpeningAction = new QAction(tr("&Sharpen Images After Downsampling"), this);
-		sharpeningAction->setCheckable(true);
-		sharpeningAction->setChecked(false);
-		sharpeningAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_E));
-		sharpeningAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(sharpeningAction, SIGNAL(triggered(bool)), this, SLOT(toggleSharpening(bool)));
-		sharpeningMenu->addAction(sharpeningAction);
-		addAction(sharpeningAction);
-
-		sharpeningOptionsAction = new QAction(tr("Sharpening &Options..."), this);
-		sharpeningOptionsAction->setShortcut(Qt::Key_O);
-		sharpeningOptionsAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(sharpeningOptionsAction, SIGNAL(triggered(bool)), this, SLOT(showSharpeningOptions()));
-		sharpeningMenu->addAction(sharpeningOptionsAction);
-		addAction(sharpeningOptionsAction);
-
-		slideshowAction = new QAction(tr("&Start Slideshow"), this);
-		slideshowAction->setEnabled(false);
-		slideshowAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_Space));
-		slideshowAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(slideshowAction, SIGNAL(triggered()), this, SLOT(toggleSlideshow()));
-		slideshowMenu->addAction(slideshowAction);
-		addAction(slideshowAction);
-
-		slideshowNoDialogAction = new QAction(this);
-		slideshowNoDialogAction->setEnabled(false);
-		slideshowNoDialogAction->setShortcut(Qt::Key_Space);
-		slideshowNoDialogAction->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(slideshowNoDialogAction, SIGNAL(triggered()), this, SLOT(toggleSlideshowNoDialog()));
-		addAction(slideshowNoDialogAction);
-
-		customAction1 = new QAction(this);
-		customAction1->setEnabled(hotkeyDialog->getHotkey1Enabled() && hotkeyDialog->getHotkeysEnabled());
-		customAction1->setShortcut(hotkeyDialog->getKeySequence1());
-		customAction1->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(customAction1, SIGNAL(triggered()), this, SLOT(triggerCustomAction1()));
-		addAction(customAction1);
-
-		customAction2 = new QAction(this);
-		customAction2->setEnabled(hotkeyDialog->getHotkey2Enabled() && hotkeyDialog->getHotkeysEnabled());
-		customAction2->setShortcut(hotkeyDialog->getKeySequence2());
-		customAction2->setShortcutContext(Qt::ApplicationShortcut);
-		QObject::connect(customAction2, SIGNAL(triggered()), this, SLOT(triggerCustomAction2()));
-		addAction(customAction2);
-
-		//mouse hide timer in fullscreen
-		mouseHideTimer = new QTimer(this);
-		QObject::connect(mouseHideTimer, SIGNAL(timeout()), this, SLOT(hideMouse()));
-
-		//timer for thread cleanup
-		threadCleanUpTimer = new QTimer(this);
-		threadCleanUpTimer->setSingleShot(true);
-		QObject::connect(threadCleanUpTimer, SIGNAL(timeout()), this, SLOT(cleanUpThreads()));
-
-		//timer for the slideshow
-		slideshowTimer = new QTimer(this);
-		QObject::connect(slideshowTimer, SIGNAL(timeout()), this, SLOT(nextSlide()));
-
-		//load settings
-		loadSettings();
-		if (settings->contains("windowPosition")) {
-			move(settings->value("windowPosition", QPoint(10, 10)).toPoint());
-		}
-		if (settings->contains("windowSize")) {
-			resize(settings->value("windowSize", QSize(900, 600)).toSize());
-		}
-		if (settings->value("maximized", false).toBool()) {
-			showMaximized();
-		}
-	}
-
-	std::shared_future<Image>& MainInterface::currentThread() {
-		return threads[currentThreadName];
-	}
-
-	bool MainInterface::exifIsRequired() const {
-		return showInfoAction->isChecked() || autoRotationAction->isChecked();
-	}
-
-	Image MainInterface::readImage(QString path, bool emitSignals) {
-		try {
-			cv::Mat image;
-			bool isPreviewImage = false;
-			Image result;
-			std::shared_ptr<ExifData> exifData;
-			//for the images we know are not supported by opencv do not attempt to read them with opencv
-			bool forcePreview = partiallySupportedExtensions.contains(QString("*.") + QFileInfo(path).suffix().toLower());
-			if (!forcePreview) image = cv::imread(path.toLocal8Bit().constData(), cv::IMREAD_UNCHANGED);
-				exifData = std::shared_ptr<ExifData>(new ExifData(path, !exifIsRequired() && image.data));
-			if (!image.data) {  
-				exifData->join();
-				if (exifData->hasPreviewImage()) {
-					image = exifData->largestReadablePreviewImage();
-					isPreviewImage = true;
-				}
-			}
-			if (image.data) {
-				QObject::connect(exifData.get(), SIGNAL(loadingFinished(ExifData*)), this, SLOT(reactToExifLoadingCompletion(ExifData*)));
-				//convert format
-				if (image.channels() == 3) {
-					cv::cvtColor(image, image, cv::COLOR_BGR2RGB);
-				}
-				if (image.depth() == CV_16U) {
-					image.convertTo(image, CV_8U, 1.0 / 256.0);
-				} else if (image.depth() == CV_32F) {
-					image.convertTo(image, CV_8U, 256.0);
-				}
-				result = Image(image, exifData, isPreviewImage);
-			}
-			if (emitSignals) emit(readImageFinished(result));
-			return result;
-		} catch (...) {
-			return Image();
-		}
-	}
-
-	void MainInterface::loadNextImage() {
-		if (loading) return;
-		std::unique_lock<std::mutex> lock(threadDeletionMutex);
-		loading = true;
-
-		if (filesInDirectory.size() != 0) {
-			currentFileIndex = nextFileIndex();
-			currentThreadName = filesInDirectory[currentFileIndex];
-			if (threads.find(filesInDirectory[currentFileIndex]) == threads.end()) {
-				loading = false;
-				return;
-			}
-			waitForThreadToFinish(currentThread());
-			//calling this function although the exif might not be set to deferred loading is no problem (it checks internally)
-			if (exifIsRequired() && currentThread().get().isValid()) currentThread().get().exif()->startLoading();
-			image = currentThread().get();
-
-			currentFileInfo = QFileInfo(getFullImagePath(currentFileIndex));
-			//start loading next image
-			if (threads.find(filesInDirectory[nextFileIndex()]) == threads.end()) {
-				threads[filesInDirectory[nextFileIndex()]] = std::async(std::launch::async,
-																						  &MainInterface::readImage,
-																						  this,
-																						  getFullImagePath(nextFileIndex()),
-																						  false);
-			}
-			lock.unlock();
-			displayImageIfOk();
-		} else {
-			lock.unlock();
-		}
-		loading = false;
-		cleanUpThreads();
-	}
-
-	void MainInterface::loadPreviousImage() {
-		if (loading) return;
-		std::unique_lock<std::mutex> lock(threadDeletionMutex);
-		loading = true;
-		if (filesInDirectory.size() != 0) {
-			currentFileIndex = previousFileIndex();
-			currentThreadName = filesInDirectory[currentFileIndex];
-			if (threads.find(filesInDirectory[currentFileIndex]) == threads.end()) {
-				loading = false;
-				return;
-			}
-			waitForThreadToFinish(currentThread());
-			//calling this function although the exif might not be set to deferred loading is no problem (it checks internally)
-			if (exifIsRequired() && currentThread().get().isValid()) currentThread().get().exif()->startLoading();
-			image = currentThread().get();
-			currentFileInfo = QFileInfo(getFullImagePath(currentFileIndex));
-			//start loading previous image
-			if (threads.find(filesInDirectory[previousFileIndex()]) == threads.end()) {
-				threads[filesInDirectory[previousFileIndex()]] = std::async(std::launch::async,
-																							  &MainInterface::readImage,
-																							  this,
-																							  getFullImagePath(previousFileIndex()),
-																							  false);
-			}
-			lock.unlock();
-			displayImageIfOk();
-		} else {
-			lock.unlock();
-		}
-		loading = false;
-		cleanUpThreads();
-	}
-
-	void MainInterface::clearThreads() {
-		for (std::map<QString, std::shared_future<Image>>::iterator it = threads.begin(); it != threads.end(); ++it) {
-			waitForThreadToFinish(it->second, false);
-		}
-		threads.clear();
-	}
-
-	size_t MainInterface::nextFileIndex() const {
-		if (filesInDirectory.size() <= 0) return -1;
-		return (currentFileIndex + 1) % filesInDirectory.size();
-	}
-
-	size_t MainInterface::previousFileIndex() const {
-		if (filesInDirectory.size() <= 0) return -1;
-		if (currentFileIndex <= 0) return filesInDirectory.size() - 1;
-		return (currentFileIndex - 1) % filesInDirectory.size();
-	}
-
-	void MainInterface::removeCurrentImageFromList(bool includeSidecarFiles, bool onlyXmp) {
-		std::unique_lock<std::mutex> lock(threadDeletionMutex);
-
-		if (filesInDirectory.size() != 0) {
-			QFileInfo imageInfo = QFileInfo(filesInDirectory[currentFileIndex]);
-			QString baseName = imageInfo.baseName();
-			QString extension = imageInfo.suffix().toLower();
-			//remove current file from directory list
-			filesInDirectory.remove(currentFileIndex);
-
-			//remove sidecar files from directory list
-			if (includeSidecarFiles) {
-				for (int i = 0; i < filesInDirectory.size(); ++i) {
-					QFileInfo fileInfo(filesInDirectory[i]);
-					if (fileInfo.baseName() == baseName && (!onlyXmp || (fileInfo.suffix().toLower() == "xmp" && supportedRawFormats.contains(extension)))) {
-						filesInDirectory.remove(i);
-						//correct the index shift
-						if (i < currentFileIndex) --currentFileIndex;
-				    --i;
-					}
-				}
-			}
-
-			//if there are no images left, quit
-			if (filesInDirectory.size() <= 0) {
-				currentFileIndex = -1;
-				lock.unlock();
-				cleanUpThreads();
-				reset();
-				return;
-			}
-			//update current file index and related variables
-			if (currentFileIndex >= filesInDirectory.size()) currentFileIndex = filesInDirectory.size() - 1;
-			currentThreadName = filesInDirectory[currentFileIndex];
-
-			//load the image that is now the current one
-			if (threads.find(filesInDirectory[currentFileIndex]) == threads.end()) {
-				threads[filesInDirectory[currentFileIndex]] = std::async(std::launch::async,
-																						   &MainInterface::readImage,
-																						   this,
-																						   getFullImagePath(currentFileIndex),
-																						   false);
-			}
-			waitForThreadToFinish(currentThread());
-			//calling this function although the exif might not be set to deferred loading is no problem (it checks internally)
-			if (exifIsRequired() && currentThread().get().isValid()) currentThread().get().exif()->startLoading();
-			image = currentThread().get();
-			currentFileInfo = QFileInfo(getFullImagePath(currentFileIndex));
-
-			//start loading next and previous image
-			if (threads.find(filesInDirectory[nextFileIndex()]) == threads.end()) {
-				threads[filesInDirectory[nextFileIndex()]] = std::async(std::launch::async,
-																						  &MainInterface::readImage,
-																						  this,
-																						  getFullImagePath(nextFileIndex()),
-																						  false);
-			}
-			if (threads.find(filesInDirectory[previousFileIndex()]) == threads.end()) {
-				threads[filesInDirectory[previousFileIndex()]] = std::async(std::launch::async,
-																							  &MainInterface::readImage,
-																							  this,
-																							  getFullImagePath(previousFileIndex()),
-																							  false);
-			}
-			lock.unlock();
-			displayImageIfOk();
-		} else {
-			lock.unlock();
-		}
-		cleanUpThreads();
-	}
-
-	void MainInterface::reset() {
-		imageView->resetImage();
-		image = sv::Image();
-		filesInDirectory.clear();
-		setWindowTitle(programTitle);
-	}
-
-	QString MainInterface::getFullImagePath(size_t index) const {
-		return currentDirectory.absoluteFilePath(filesInDirectory[index]);
-	}
-
-	void MainInterface::loadImage(QString path) {
-		if (loading) return;
-		std::unique_lock<std::mutex> lock(threadDeletionMutex);
-		loading = true;
-		//find the path in the current directory listing
-		QFileInfo fileInfo = QFileInfo(QDir::cleanPath(path));
-		QDir directory = fileInfo.absoluteDir();
-		QString filename = fileInfo.fileName();
-		//always scan directory; uncomment to scan only if different directory
-		//if (directory != currentDirectory || noCurrentDir) {
-			currentDirectory = directory;
-			noCurrentDir = false;
-			QStringList filters = supportedExtensions;
-			filters << "*.bmp" << "*.dib" << "*.jpeg" << "*.jpg" << "*.jpe" << "*.jpeg" << "*.jp2" << "*.png" << "*.webp" << "*.pbm" << "*.pgm" << "*.ppm" << "*.sr" << "*.ras" << "*.tiff" << "*.tif";
-			if (includePartiallySupportedFilesAction->isChecked()) {
-				filters.append(partiallySupportedExtensions);
-			}
-			QStringList contents = directory.entryList(filters, QDir::Files);
-			QCollator collator;
-			collator.setNumericMode(true);
-			std::sort(contents.begin(), contents.end(), collator);
-			filesInDirectory = contents.toVector();
-		//}
-		if (filesInDirectory.size() == 0 || currentFileIndex < 0 || currentFileIndex >= filesInDirectory.size() || filesInDirectory.at(currentFileIndex) != filename) {
-			currentFileIndex = filesInDirectory.indexOf(filename);
-		}
-		currentThreadName = filename;
-		currentFileInfo = fileInfo;
-		clearThreads();
-		threads[filename] = std::async(std::launch::async, &MainInterface::readImage, this, path, true);
-		setWindowTitle(windowTitle() + QString(tr(" - Loading...")));
-		statusHint = tr("Loading...");
-		imageView->update();
-	}
-
-	void MainInterface::loadImages(QStringList paths) {
-		if (loading) return;
-		std::unique_lock<std::mutex> lock(threadDeletionMutex);
-		loading = true;
-		
-		QString path = paths.first();
-		//find the path in the current directory listing
-		QFileInfo fileInfo = QFileInfo(QDir::cleanPath(path));
-		QDir directory = fileInfo.absoluteDir();
-		QString filename = fileInfo.fileName();
-		currentDirectory = directory;
-		noCurrentDir = false;
-		//remove all images that are not in the same directory
-		QMutableListIterator<QString> it(paths);
-		while (it.hasNext()) {
-			if (QFileInfo(it.next()).absoluteDir() != currentDirectory) {
-				it.remove();
-			}
-		}
-		filesInDirectory.resize(paths.size());
-		for (int i = 0; i < paths.size(); ++i) {
-			filesInDirectory[i] = QFileInfo(QDir::cleanPath(paths[i])).fileName();
-		}
-
-		if (filesInDirectory.size() == 0 || currentFileIndex < 0 || currentFileIndex >= filesInDirectory.size() || filesInDirectory.at(currentFileIndex) != filename) {
-			currentFileIndex = filesInDirectory.indexOf(filename);
-		}
-		currentThreadName = filename;
-		currentFileInfo = fileInfo;
-		clearThreads();
-		threads[filename] = std::async(std::launch::async, &MainInterface::readImage, this, path, true);
-		setWindowTitle(windowTitle() + QString(tr(" - Loading...")));
-		statusHint = tr("Loading...");
-		imageView->update();
-	}
-
-	void MainInterface::displayImageIfOk() {
-		if (image.isValid()) {
-			currentImageUnreadable = false;
-			imageView->setImage(image.mat());
-			if (autoRotationAction->isChecked()) {
-				autoRotateImage();
-			}
-		} else {
-			currentImageUnreadable = true;
-			imageView->resetImage();
-		}
-		setWindowTitle(QString("%1%5 - %2 - %3 of %4").arg(currentFileInfo.fileName(),
-															   programTitle).arg(currentFileIndex + 1).arg(filesInDirectory.size()).arg(image.isPreviewImage() ? " [Preview]" : ""));
-	}
-
-	void MainInterface::autoRotateImage() {
-		if (image.isValid()) {
-			image.exif()->join();
-			if (image.exif()->hasExif()) {
-				long orientation = image.exif()->orientation();
-				imageView->setRotation(userRotation);
-				orientation = (orientation + 1) / 2;
-				if (orientation == 3) {
-					imageView->rotateBy(90);
-				} else if (orientation == 4) {
-					imageView->rotateBy(-90);
-				} else if (orientation == 2) {
-					imageView->rotateBy(180);
-				}
-			}
-		}
-	}
-
-	void MainInterface::enterFullscreen() {
-		//imageView->setInterfaceBackgroundColor(Qt::black);
-		showFullScreen();
-		hideMenuBar();
-		enableAutomaticMouseHide();
-		fullscreenAction->setChecked(true);
-	}
-
-	void MainInterface::exitFullscreen() {
-		//QPalette palette = qApp->palette();
-		//imageView->setInterfaceBackgroundColor(palette.base().color());
-		if (settings->value("maximized", false).toBool()) {
-			showMaximized();
-		} else {
-			showNormal();
-		}
-		if (menuBarAutoHideAction->isChecked()) showMenuBar();
-		disableAutomaticMouseHide();
-		fullscreenAction->setChecked(false);
-	}
-
-	void MainInterface::infoPaintFunction(QPainter& canvas) {
-		canvas.setRenderHint(QPainter::Antialiasing, true);
-		QPen textPen(Qt::black);
-		canvas.setPen(textPen);
-		canvas.setBrush(Qt::NoBrush);
-		QFont font;
-		font.setPointSize(fontSize);
-		canvas.setFont(font);
-		QColor base = Qt::white;
-		base.setAlpha(200);
-		canvas.setBackground(base);
-		canvas.setBackgroundMode(Qt::OpaqueMode);
-		QFontMetrics metrics(font);
-		if (currentImageUnreadable && statusHint.isEmpty()) {
-			QString message = tr("This file could not be read:");
-			canvas.drawText(QPoint((canvas.device()->width() - metrics.horizontalAdvance(message)) / 2.0, canvas.device()->height() / 2.0 - 0.5*lineSpacing),
-							message);
-			canvas.drawText(QPoint((canvas.device()->width() - metrics.horizontalAdvance(currentFileInfo.fileName())) / 2.0,
-								   canvas.device()->height() / 2.0 + 0.5*lineSpacing + metrics.height()),
-							currentFileInfo.fileName());
-		}
-		if (!statusHint.isEmpty()) {
-			canvas.drawText(QPoint((canvas.device()->width() - metrics.horizontalAdvance(statusHint)) / 2.0, canvas.device()->height() / 2.0 + 0.5*metrics.height()),
-							statusHint);
-		}
-		if (showInfoAction->isChecked() && imageView->getImageAssigned()) {
-			//draw current filename
-			canvas.drawText(QPoint(30, 30 + metrics.height()),
-							currentFileInfo.fileName());
-			int sizeAndResolutionTopOffset = 30 + lineSpacing + 2 * metrics.height();
-			if (image.isValid()) {
-				QString resolution = QString::fromWCharArray(L"%1\u2006x\u2006%2").arg(image.mat().cols).arg(image.mat().rows);
-				canvas.drawText(QPoint(30, sizeAndResolutionTopOffset),
-								QString::fromWCharArray(L"%1, %2\u2006Mb").arg(resolution).arg(currentFileInfo.size() / 1048576.0, 0, 'f', 2));
-				if (image.exif()->isReady()) {
-					if (image.exif()->hasExif()) {
-						//get camera model, speed, aperture and ISO
-						QString cameraModel = image.exif()->cameraModel();
-						QString lensModel = image.exif()->lensModel();
-						QString aperture = image.exif()->fNumber();
-						QString speed = image.exif()->exposureTime();
-						QString focalLength = image.exif()->focalLength();
-						QString equivalentFocalLength = image.exif()->focalLength35mmEquivalent();
-						QString exposureBias = image.exif()->exposureBias();
-						QString iso = image.exif()->iso();
-						QString captureDate = image.exif()->captureDate();
-						//calculate the v coordinates for the lines
-						int heightOfOneLine = lineSpacing + metrics.height();
-						int topOffset = 30 + 2 * lineSpacing + 3 * metrics.height();
-
-						//draw the EXIF text (note \u2005 is a sixth of a quad)
-						if (!cameraModel.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											cameraModel);
-							topOffset += heightOfOneLine;
-						}
-						if (!lensModel.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											lensModel);
-							topOffset += heightOfOneLine;
-						}
-						if (!focalLength.isEmpty() && !equivalentFocalLength.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString::fromWCharArray(L"%1\u2006mm (\u2261 %2\u2006mm)").arg(focalLength).arg(equivalentFocalLength));
-							topOffset += heightOfOneLine;
-						} else if (!focalLength.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString::fromWCharArray(L"%1\u2006mm").arg(focalLength));
-							topOffset += heightOfOneLine;
-						} else if (!equivalentFocalLength.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString::fromWCharArray(L"%1\u2006mm (35\u2006mm equivalent)").arg(equivalentFocalLength));
-							topOffset += heightOfOneLine;
-						}
-						if (!speed.isEmpty() && !aperture.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString::fromWCharArray(L"%1\u2006s @ f/%2").arg(speed).arg(aperture));
-							topOffset += heightOfOneLine;
-						} else if (!speed.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString::fromWCharArray(L"%1\u2006s").arg(speed));
-							topOffset += heightOfOneLine;
-						} else if (!aperture.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString("f/%1").arg(aperture));
-							topOffset += heightOfOneLine;
-						}
-						if (!iso.isEmpty() && !exposureBias.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString::fromWCharArray(L"ISO\u2006%1, %2\u2006EV").arg(iso).arg(exposureBias));
-						  topOffset += heightOfOneLine;
-						} else if (!iso.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString::fromWCharArray(L"ISO\u2006%1").arg(iso));
-							topOffset += heightOfOneLine;
-						} else if (!exposureBias.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString::fromWCharArray(L"%1\u2006EV").arg(exposureBias));
-							topOffset += heightOfOneLine;
-						}
-						if (!captureDate.isEmpty()) {
-							canvas.drawText(QPoint(30, topOffset),
-											QString("%1").arg(captureDate));
-							topOffset += heightOfOneLine;
-						}
-						if (image.isPreviewImage()) {
-							canvas.drawText(QPoint(30, topOffset), "[Preview Image]");
-						}
-					}
-				} else {
-					canvas.drawText(QPoint(30, 30 + 2 * lineSpacing + 3 * metrics.height()),
-									tr("Loading EXIF..."));
-				}
-			}
-		}
-		if (zoomLevelAction->isChecked() && imageView->getImageAssigned()) {
-			QString message = QString::number(imageView->getCurrentPreviewScalingFactor() * 100, 'f', 1).append("%");
-			canvas.drawText(QPoint(30, canvas.device()->height() - 30), message);
-		}
-	}
-
-	bool MainInterface::applicationIsInstalled() {
-#ifdef Q_OS_WIN
-		QSettings registry("HKEY_LOCAL_MACHINE\\SOFTWARE", QSettings::NativeFormat);
-		return registry.contains("Microsoft/Windows/CurrentVersion/Uninstall/AcuteViewer/UninstallString");
-#else
-		return false;
-#endif
-
-	}
-
-	void MainInterface::changeFontSizeBy(int value) {
-		if (showInfoAction->isChecked() || zoomLevelAction->isChecked()) {
-			if (fontSize + value >= 1) {
-				fontSize += value;
-				settings->setValue("fontSize", fontSize);
-				imageView->update();
-			}
-		}
-	}
-
-	void MainInterface::changeLineSpacingBy(int value) {
-		if (showInfoAction->isChecked()) {
-			if (int(lineSpacing) + value >= 0) {
-				lineSpacing += value;
-				settings->setValue("fontSize", lineSpacing);
-				imageView->update();
-			}
-		}
-	}
-
-	void MainInterface::loadSettings() {
-		fontSize = settings->value("fontSize", 14).toUInt();
-		if (fontSize < 1) fontSize = 1;
-		lineSpacing = settings->value("lineSpacing", 10).toUInt();
-		fileActionAction->setChecked(settings->value("enableHotkeys", true).toBool());
-		showInfoAction->setChecked(settings->value("showImageInfo", false).toBool());
-		zoomLevelAction->setChecked(settings->value("showZoomLevel", false).toBool());
-		enlargementAction->setChecked(settings->value("enlargeSmallImages", false).toBool());
-		toggleSmallImageUpscaling(enlargementAction->isChecked());
-		smoothingAction->setChecked(settings->value("useSmoothEnlargmentInterpolation", false).toBool());
-		toggleEnglargmentInterpolationMethod(smoothingAction->isChecked());
-		sharpeningAction->setChecked(settings->value("sharpenImagesAfterDownscale", false).toBool());
-		toggleSharpening(sharpeningAction->isChecked());
-		menuBarAutoHideAction->setChecked(!settings->value("autoHideMenuBar", true).toBool());
-		toggleMenuBarAutoHide(menuBarAutoHideAction->isChecked());
-		if (imageView->OpenClAvailable()) {
-			gpuAction->setChecked(settings->value("useGpu", true).toBool());
-		} else {
-			gpuAction->setChecked(false);
-			gpuAction->setEnabled(false);
-		}
-		toggleGpu(gpuAction->isChecked());
-		QColor backgroundColor = settings->value("backgroundColor", QColor(Qt::black)).value<QColor>();
-		imageView->setInterfaceBackgroundColor(backgroundColor);
-		if (backgroundColor == Qt::black) {
-			backgroundColorBlackAction->setChecked(true);
-		} else if (backgroundColor == Qt::white) {
-			backgroundColorWhiteAction->setChecked(true);
-		} else if (backgroundColor == darkGray) {
-			backgroundColorGrayAction->setChecked(true);
-		} else {
-			backgroundColorCustomAction->setChecked(true);
-		}
-		includePartiallySupportedFilesAction->setChecked(settings->value("includePreviewOnlyFiles", true).toBool());
-		autoRotationAction->setChecked(settings->value("autoRotateImages", true).toBool());
-	}
-
-	void MainInterface::deleteCurrentImage(bool askForConfirmation, bool includeSidecarFiles, bool onlyXmp) {
-		if (askForConfirmation) {
-			QMessageBox msgBox;
-			msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
-			msgBox.setDefaultButton(QMessageBox::No);
-			msgBox.setWindowTitle(tr("Delete File"));
-			msgBox.setText(tr("Please confirm that you want to delete this file."));
-			msgBox.setButtonText(QMessageBox::Yes, tr("Delete"));
-			msgBox.setButtonText(QMessageBox::No, tr("Do not Delete"));
-			msgBox.setIcon(QMessageBox::Question);
-			if (msgBox.exec() == QMessageBox::No) return;
-		}
-
-		QString filepath = getFullImagePath(currentFileIndex);
-		if (QFileInfo(filepath).exists()) {
-			if (utility::moveFileToRecycleBin(filepath)) {
-				if (includeSidecarFiles && supportedRawFormats.contains(QFileInfo(filepath).suffix().toLower())) {
-					QString extension = onlyXmp ? "xmp" : "*";
-					QStringList filters;
-					filters << QString("%1.%2").arg(QFileInfo(filepath).baseName(), extension);
-					QStringList contents = currentDirectory.entryList(filters, QDir::Files);
-					for (QString const & file : contents) {
-						if (!utility::moveFileToRecycleBin(currentDirectory.absoluteFilePath(file))) {
-							QMessageBox::critical(this,
-												  tr("Sidecar File Not Deleted"),
-												  tr("The sidecar file %1 could not be deleted. Please check that you have the required permissions and that the path length does not exceed MAX_PATH.").arg(file),
-												  QMessageBox::StandardButton::Close,
-												  QMessageBox::StandardButton::Close);
-						}
-					}
-				}
-				removeCurrentImageFromList(includeSidecarFiles, onlyXmp);
-			} else {
-#ifdef Q_OS_WIN
-				QMessageBox::critical(this,
-									  tr("File Not Deleted"),
-									  tr("The file could not be deleted. Please check that you have the required permissions and that the path length does not exceed MAX_PATH."),
-									  QMessageBox::StandardButton::Close,
-									  QMessageBox::StandardButton::Close);
-#else
-				QMessageBox::critical(this,
-									  tr("File Not Deleted"),
-									  tr("The file could not be deleted. Please check that you have the required permissions. It might also be that your trash folder is not at the default location."),
-									  QMessageBox::StandardButton::Close,
-									  QMessageBox::StandardButton::Close);
-#endif
-			}
-
-		} else {
-			QMessageBox::critical(this,
-								  tr("File Not Found"),
-								  tr("The file could not be deleted because it no longer exists."),
-								  QMessageBox::StandardButton::Close,
-								  QMessageBox::StandardButton::Close);
-		}
-	}
-
-	void MainInterface::moveCurrentImage(QString const & newFolder, bool askForConfirmation, bool includeSidecarFiles, bool onlyXmp) {
-		if (askForConfirmation) {
-			QMessageBox msgBox;
-			msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
-			msgBox.setDefaultButton(QMessageBox::No);
-			msgBox.setWindowTitle(tr("Move File"));
-			msgBox.setText(tr("Please confirm that you want to move this file to the folder you specified."));
-			msgBox.setButtonText(QMessageBox::Yes, tr("Move"));
-			msgBox.setButtonText(QMessageBox::No, tr("Do not Move"));
-			msgBox.setIcon(QMessageBox::Question);
-			if (msgBox.exec() == QMessageBox::No) return;
-		}
-		QDir dir = QDir(newFolder);
-		QString oldPath = getFullImagePath(currentFileIndex);
-		QString newPath = dir.absoluteFilePath(filesInDirectory[currentFileIndex]);
-		if (utility::moveFile(oldPath, newPath, false, this)) {
-			if (includeSidecarFiles && supportedRawFormats.contains(QFileInfo(oldPath).suffix().toLower())) {
-				QString extension = onlyXmp ? "xmp" : "*";
-				QStringList filters;
-				filters << QString("%1.%2").arg(QFileInfo(oldPath).baseName(), extension);
-				QStringList contents = currentDirectory.entryList(filters, QDir::Files);
-				for (QString const & file : contents) {
-					if (!utility::moveFile(currentDirectory.absoluteFilePath(file), dir.absoluteFilePath(file), true, this)) {
-						QMessageBox::critical(this,
-											  tr("Sidecar File Not Moved"),
-											  tr("The sidecar file %1 could not be deleted. Please check that you have the required permissions and that the path length does not exceed MAX_PATH.").arg(file),
-											  QMessageBox::StandardButton::Close,
-											  QMessageBox::StandardButton::Close);
-					}
-				}
-			}
-			removeCurrentImageFromList(includeSidecarFiles, onlyXmp);
-		}
-	}
-
-	void MainInterface::copyCurrentImage(QString const & newFolder, bool askForConfirmation, bool includeSidecarFiles, bool onlyXmp) {
-		if (askForConfirmation) {
-			QMessageBox msgBox;
-			msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
-			msgBox.setDefaultButton(QMessageBox::No);
-			msgBox.setWindowTitle(tr("Copy File"));
-			msgBox.setText(tr("Please confirm that you want to copy this file to the folder you specified."));
-			msgBox.setButtonText(QMessageBox::Yes, tr("Copy"));
-			msgBox.setButtonText(QMessageBox::No, tr("Do not Copy"));
-			msgBox.setIcon(QMessageBox::Question);
-			if (msgBox.exec() == QMessageBox::No) return;
-		}
-		QDir dir = QDir(newFolder);
-		QString oldPath = getFullImagePath(currentFileIndex);
-		QString newPath = dir.absoluteFilePath(filesInDirectory[currentFileIndex]);
-		if (utility::copyFile(oldPath, newPath, false, this)) {
-			if (includeSidecarFiles && supportedRawFormats.contains(QFileInfo(oldPath).suffix().toLower())) {
-				QString extension = onlyXmp ? "xmp" : "*";
-				QStringList filters;
-				filters << QString("%1.%2").arg(QFileInfo(oldPath).baseName(), extension);
-				QStringList contents = currentDirectory.entryList(filters, QDir::Files);
-				for (QString const & file : contents) {
-					if (!utility::copyFile(currentDirectory.absoluteFilePath(file), dir.absoluteFilePath(file), true, this)) {
-						QMessageBox::critical(this,
-											  tr("Sidecar File Not Copied"),
-											  tr("The sidecar file %1 could not be copied. Please check that you have the required permissions and that the path length does not exceed MAX_PATH.").arg(file),
-											  QMessageBox::StandardButton::Close,
-											  QMessageBox::StandardButton::Close);
-					}
-				}
-			}
-		}
-
-	}
-
-	//============================================================================ PRIVATE SLOTS =============================================================================\\
-
-	void MainInterface::refresh() {
-		if (currentFileIndex >= 0 && filesInDirectory.size() > 0) {
-			loadImage(getFullImagePath(currentFileIndex));
-		}
-	}
-
-	void MainInterface::showHotkeyDialog() {
-		disableAutomaticMouseHide();
-		hotkeyDialog->show();
-	}
-
-	void MainInterface::nextSlide() {
-		loadNextImage();
-		if (!settings->value("slideshowLoop", false).toBool() && currentFileIndex == (filesInDirectory.size() - 1)) {
-			stopSlideshow();
-		}
-	}
-
-	void MainInterface::cleanUpThreads() {
-		try {
-			std::lock_guard<std::mutex> lock(threadDeletionMutex);
-			size_t previousIndex = previousFileIndex();
-			size_t nextIndex = nextFileIndex();
-			for (std::map<QString, std::shared_future<Image>>::iterator it = threads.begin(); it != threads.end();) {
-				int index = filesInDirectory.indexOf(it->first);
-				//see if the thread has finished loading
-				//also the exif should have finished loading to prevent blocking, check if it's valid first to not derefence an invalid pointer
-				if (index != currentFileIndex
-					&& index != previousIndex
-					&& index != nextIndex
-					&& it->second.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready
-					&& (!it->second.get().isValid() || it->second.get().exif()->isReady() || it->second.get().exif()->isDeferred())) {
-					it = threads.erase(it);
-				} else {
-					++it;
-				}
-			}
-			if (threads.size() > 3) threadCleanUpTimer->start(threadCleanUpInterval);
-		} catch (...) {
-			//Probably couldn't lock the mutex (thread already owns it?)
-			if (threads.size() > 3) threadCleanUpTimer->start(threadCleanUpInterval);
-		}
-	}
-
-	void MainInterface::quit() {
-		QCoreApplication::quit();
-	}
-
-	void MainInterface::saveWindowSize() {
-		settings->setValue("windowSize", size());
-		settings->setValue("windowPosition", pos());
-		QMessageBox::information(this,
-								 tr("Successfull"),
-								 tr("The current size and position of the window have been saved as the new default."),
-								 QMessageBox::Close);
-	}
-
-	void MainInterface::hideMouse() const {
-		qApp->setOverrideCursor(Qt::BlankCursor);
-		mouseHideTimer->stop();
-	}
-
-	void MainInterface::showMouse() const {
-		qApp->setOverrideCursor(Qt::ArrowCursor);
-	}
-
-	void MainInterface::enableAutomaticMouseHide() {
-		if (isFullScreen() && !menuBar()->isVisible() && !slideshowDialog->isVisible() && !sharpeningDialog->isVisible() && !hotkeyDialog->isVisible()) {
-			mouseHideTimer->start(mouseHideDelay);
-		}
-	}
-
-	void MainInterface::disableAutomaticMouseHide() {
-		mouseHideTimer->stop();
-		showMouse();
-	}
-
-	void MainInterface::showMenuBar() {
-		if (isFullScreen()) disableAutomaticMouseHide();
-		menuBar()->setVisible(true);
-	}
-
-	void MainInterface::hideMenuBar(QAction* triggeringAction) {
-		if (!menuBarAutoHideAction->isChecked() || isFullScreen()) {
-			menuBar()->setVisible(false);
-			enableAutomaticMouseHide();
-		}
-	}
-
-	void MainInterface::populateApplicationMenu() {
-		applicationMenu->removeAction(installAction);
-		applicationMenu->removeAction(uninstallAction);
-		if (applicationIsInstalled()) {
-			applicationMenu->insertAction(aboutAction, uninstallAction);
-		} else {
-			applicationMenu->insertAction(aboutAction, installAction);
-		}
-
-	}
-
-	void MainInterface::runInstaller() {
-#ifdef Q_OS_WIN
-		QString installerPath = QDir(QCoreApplication::applicationDirPath()).absoluteFilePath("WinInstaller.exe");
-		if (QFileInfo(installerPath).exists()) {
-			ShellExecuteW(GetDesktopWindow(),
-						  nullptr,
-						  reinterpret_cast<LPCWSTR>(installerPath.utf16()),
-						  nullptr,
-						  reinterpret_cast<LPCWSTR>(QCoreApplication::applicationDirPath().utf16()),
-						  SW_SHOWNORMAL);
-			QCoreApplication::quit();
-		} else {
-			QMessageBox::critical(this,
-								  tr("Installer not found"),
-								  tr("The installer executable (WinInstaller.exe) could not be found. Make sure it is located in the same directory as AcuteViewer.exe."),
-								  QMessageBox::Close);
-		}
-#endif
-	}
-
-	void MainInterface::runUninstaller() {
-#ifdef Q_OS_WIN
-		QString installerPath = QDir::toNativeSeparators(QDir(QCoreApplication::applicationDirPath()).absoluteFilePath("WinInstaller.exe"));
-		if (QFileInfo(installerPath).exists()) {
-			ShellExecuteW(GetDesktopWindow(),
-						  nullptr,
-						  reinterpret_cast<LPCWSTR>(installerPath.utf16()),
-						  L"-uninstall",
-						  reinterpret_cast<LPCWSTR>(QCoreApplication::applicationDirPath().utf16()),
-						  SW_SHOWNORMAL);
-			QCoreApplication::quit();
-		} else {
-			QMessageBox::critical(this,
-								  tr("Installer not found"),
-								  tr("The installer executable (WinInstaller.exe) could not be found. Make sure it is located in the same directory as AcuteViewer.exe."),
-								  QMessageBox::Close);
-		}
-#endif
-	}
-
-	void MainInterface::resetSettings() {
-		if (QMessageBox::Yes == QMessageBox::question(this,
-													  tr("Reset Application Settings"),
-													  tr("Are you sure you want to reset all application settings to the default values?"),
-													  QMessageBox::Yes | QMessageBox::No)) {
-			settings->clear();
-			loadSettings();
-			imageView->update();
-			QMessageBox::information(this,
-									 tr("Reset Successfull"),
-									 tr("The application settings have been reset to the default values."),
-									 QMessageBox::Close);
-		}
-	}
-
-	void MainInterface::toggleSlideshow() {
-		if (slideshowTimer->isActive()) {
-			stopSlideshow();
-		} else {
-			slideshowDialog->show();
-			disableAutomaticMouseHide();
-		}
-	}
-
-	void MainInterface::toggleSlideshowNoDialog() {
-		if (slideshowTimer->isActive()) {
-			stopSlideshow();
-		} else {
-			startSlideshow();
-		}
-	}
-
-	void MainInterface::startSlideshow() {
-		slideshowAction->setText(tr("&Stop Slideshow"));
-		slideshowTimer->start(std::abs(settings->value("slideDelay", 3).toDouble()) * 1000);
-	}
-
-	void MainInterface::stopSlideshow() {
-		slideshowAction->setText(tr("&Start Slideshow"));
-		slideshowTimer->stop();
-	}
-
-	void MainInterface::toggleFullscreen() {
-		if (isFullScreen()) {
-			exitFullscreen();
-		} else {
-			enterFullscreen();
-		}
-	}
-
-	void MainInterface::rotateLeft() {
-		userRotation -= 90;
-		imageView->rotateLeft();
-	}
-
-	void MainInterface::rotateRight() {
-		userRotation += 90;
-		imageView->rotateRight();
-	}
-
-	void MainInterface::resetRotation() {
-		userRotation = 0;
-		imageView->setRotation(0);
-		if (autoRotationAction->isChecked()) autoRotateImage();
-	}
-
-	void MainInterface::zoomTo100() {
-		skipNextAltRelease = true;
-		imageView->zoomToHundredPercent();
-	}
-
-	void MainInterface::toggleGpu(bool value) {
-		imageView->setUseGpu(value);
-		settings->setValue("useGpu", value);
-	}
-
-	void MainInterface::toggleInfoOverlay(bool value) {
-		//if the thread of the currently displayed image is ready, start loading exif
-		if (!currentThreadName.isEmpty()
-			&& currentThread().valid()
-			&& currentThread().wait_for(std::chrono::milliseconds(0)) == std::future_status::ready
-			&& currentThread().get().isValid()) {
-			currentThread().get().exif()->startLoading();
-		}
-		if (image.isValid()) image.exif()->startLoading();
-		imageView->update();
-		settings->setValue("showImageInfo", value);
-	}
-
-	void MainInterface::toggleZoomLevelOverlay(bool value) {
-		imageView->update();
-		settings->setValue("showZoomLevel", value);
-	}
-
-	void MainInterface::reactToReadImageCompletion(Image image) {
-		this->image = image;
-		//calling this function although the exif might not be set to deferred loading is no problem (it checks internally)
-		if (exifIsRequired() && currentThread().get().isValid()) currentThread().get().exif()->startLoading();
-		statusHint = QString();
-		displayImageIfOk();
-		if (filesInDirectory.size() != 0) {
-			//preload next and previous image in background
-			std::lock_guard<std::mutex> lock(threadDeletionMutex);
-			if (threads.find(filesInDirectory[previousFileIndex()]) == threads.end()) {
-				threads[filesInDirectory[previousFileIndex()]] = std::async(std::launch::async,
-																							  &MainInterface::readImage,
-																							  this,
-																							  getFullImagePath(previousFileIndex()),
-																							  false);
-			}
-			if (threads.find(filesInDirectory[nextFileIndex()]) == threads.end()) {
-				threads[filesInDirectory[nextFileIndex()]] = std::async(std::launch::async,
-																						  &MainInterface::readImage,
-																						  this, getFullImagePath(nextFileIndex()),
-																						  false);
-			}
-		}
-		slideshowAction->setEnabled(true);
-		slideshowNoDialogAction->setEnabled(true);
-		refreshAction->setEnabled(true);
-		loading = false;
-	}
-
-	void MainInterface::reactToExifLoadingCompletion(ExifData* sender) {
-		if (showInfoAction->isChecked()) {
-		//if the sender is the currently displayed image
-			if (image.exif().get() == sender) {
-				update();
-			}
-		}
-	}
-
-	void MainInterface::openDialog() {
-		QString supportedFiles = QString("Fully Supported Images (") + supportedExtensions.join(" ") + QString(")");
-		QStringList allTypes;
-		allTypes << supportedExtensions << partiallySupportedExtensions;
-		allTypes.sort();
-		QString partiallySupportedFiles = QString("All Supported Images (") + allTypes.join(" ") + QString(")");
-		QString filters = QString("All Files (*.*);; %1;; %2;;").arg(partiallySupportedFiles).arg(supportedFiles);
-		QStringList paths = QFileDialog::getOpenFileNames(this,
-														  tr("Open Config File"),
-														  settings->value("lastOpenPath", QDir::rootPath()).toString(),
-														  filters);
-
-		if (!(paths.size() < 1)) {
-			settings->setValue("lastOpenPath", QFileInfo(paths.at(0)).path());
-			if (paths.size() == 1) {
-				loadImage(paths.at(0));
-			} else {
-				loadImages(paths);
-			}
-		}
-	}
-
-	void MainInterface::toggleEnglargmentInterpolationMethod(bool value) {
-		imageView->setUseSmoothTransform(value);
-		settings->setValue("useSmoothEnlargmentInterpolation", value);
-	}
-
-	void MainInterface::toggleSmallImageUpscaling(bool value) {
-		imageView->setPreventMagnificationInDefaultZoom(!value);
-		settings->setValue("enlargeSmallImages", value);
-	}
-
-	void MainInterface::toggleSharpening(bool value) {
-		imageView->setEnablePostResizeSharpening(value);
-		settings->setValue("sharpenImagesAfterDownscale", value);
-	}
-
-	void MainInterface::toggleMenuBarAutoHide(bool value) {
-		settings->setValue("autoHideMenuBar", !value);
-		if (value) {
-			showMenuBar();
-		} else {
-			hideMenuBar();
-		}
-	}
-
-	void MainInterface::togglePreviewOnlyFiles(bool value) {
-		settings->setValue("includePreviewOnlyFiles", value);
-		refresh();
-	}
-
-	void MainInterface::showSharpeningOptions() {
-		disableAutomaticMouseHide();
-		sharpeningDialog->show();
-		sharpeningDialog->raise();
-		sharpeningDialog->activateWindow();
-	}
-
-	void MainInterface::updateSharpening() {
-		sharpeningAction->setChecked(settings->value("sharpenImagesAfterDownscale", false).toBool());
-		imageView->setPostResizeSharpening(sharpeningAction->isChecked(),
-												 settings->value("sharpeningStrength", 0.5).toDouble(),
-												 settings->value("sharpeningRadius", 1).toDouble());
-	}
-
-	void MainInterface::changeBackgroundColor(QAction* action) {
-		if (action == backgroundColorBlackAction) {
-			imageView->setInterfaceBackgroundColor(Qt::black);
-			settings->setValue("backgroundColor", QColor(Qt::black));
-		} else if (action == backgroundColorGrayAction) {
-			imageView->setInterfaceBackgroundColor(darkGray);
-			settings->setValue("backgroundColor", darkGray);
-		} else if (action == backgroundColorWhiteAction) {
-			imageView->setInterfaceBackgroundColor(Qt::white);
-			settings->setValue("backgroundColor", QColor(Qt::white));
-		} else if (action == backgroundColorCustomAction) {
-			QColor color = QColorDialog::getColor(settings->value("lastCustomColor", QColor(Qt::black)).value<QColor>(), this, tr("Choose Background Colour"));
-			if (color.isValid()) {
-				settings->setValue("lastCustomColor", color);
-				settings->setValue("backgroundColor", color);
-				imageView->setInterfaceBackgroundColor(color);
-			} else {
-				if (imageView->getInterfaceBackgroundColor() == Qt::black) {
-					backgroundColorBlackAction->setChecked(true);
-				} else if (imageView->getInterfaceBackgroundColor() == darkGray) {
-					backgroundColorGrayAction->setChecked(true);
-				} else if (imageView->getInterfaceBackgroundColor() == Qt::white) {
-					backgroundColorWhiteAction->setChecked(true);
-				}
-			}
-		}
-	}
-
-	void MainInterface::toggleAutoRotation(bool value) {
-		settings->setValue("autoRotateImages", value);
-		if (value) {
-			autoRotateImage();
-		} else {
-			imageView->setRotation(userRotation);
-		}
-	}
-
-	void MainInterface::triggerCustomAction1() {
-		if (filesInDirectory.size() > 0 && !loading) {
-			loading = true;
-			if (hotkeyDialog->getAction1() == 0) {
-				statusHint = tr("Deleting...");
-				update();
-				deleteCurrentImage(hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles());
-			} else if (hotkeyDialog->getAction1() == 1) {
-				statusHint = tr("Moving...");
-				update();
-				moveCurrentImage(hotkeyDialog->getFolder1(), hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles());
-			} else if (hotkeyDialog->getAction1() == 2) {
-				statusHint = tr("Copying...");
-				update();
-				copyCurrentImage(hotkeyDialog->getFolder1(), hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles());
-			}
-			statusHint = QString();
-			loading = false;
-			update();
-		}
-	}
-
-	void MainInterface::triggerCustomAction2() { 
-		if (filesInDirectory.size() > 0 && !loading) {
-			loading = true;
-			if (hotkeyDialog->getAction2() == 0) {
-				statusHint = tr("Deleting...");
-				update();
-				deleteCurrentImage(hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles(), hotkeyDialog->getSidecarType());
-			} else if (hotkeyDialog->getAction2() == 1) {
-				statusHint = tr("Moving...");
-				update();
-				moveCurrentImage(hotkeyDialog->getFolder2(), hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles(), hotkeyDialog->getSidecarType());
-			} else if (hotkeyDialog->getAction2() == 2) {
-				statusHint = tr("Copying...");
-				update();
-				copyCurrentImage(hotkeyDialog->getFolder2(), hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles(), hotkeyDialog->getSidecarType());
-			}
-			statusHint = QString();
-			loading = false;
-			update();
-		}
-	}
-
-	void MainInterface::updateCustomHotkeys() {
-		fileActionAction->setChecked(hotkeyDialog->getHotkeysEnabled());
-		customAction1->setEnabled(hotkeyDialog->getHotkeysEnabled() && hotkeyDialog->getHotkey1Enabled());
-		customAction2->setEnabled(hotkeyDialog->getHotkeysEnabled() && hotkeyDialog->getHotkey2Enabled());
-		customAction1->setShortcut(hotkeyDialog->getKeySequence1());
-		customAction2->setShortcut(hotkeyDialog->getKeySequence2());
-	}
-
+#include "MainInterface.h"
+#ifdef Q_OS_WIN
+#include <shellapi.h>
+#endif
+
+namespace sv {
+
+	MainInterface::MainInterface(QString openWithFilename, QWidget *parent)
+		: QMainWindow(parent),
+		settings(new QSettings(QSettings::IniFormat, QSettings::UserScope, "Acute Viewer", "Acute Viewer")) {
+
+		initialize();
+
+		if (openWithFilename != QString()) {
+			loadImage(openWithFilename);
+		}
+	}
+
+	MainInterface::MainInterface(QStringList openWithFilenames, QWidget * parent) 
+		: QMainWindow(parent),
+		settings(new QSettings(QSettings::IniFormat, QSettings::UserScope, "Acute Viewer", "Acute Viewer")) {
+
+		initialize();
+		
+		loadImages(openWithFilenames);
+	}
+
+	MainInterface::~MainInterface() {
+		//make sure no decode is running anymore that accesses members of this object
+		for (QString const& key : imageCache.keys()) {
+			ImageThread* thread = imageCache.peek(key);
+			*thread->cancellation = true;
+			if (!threadPool->cancel(thread->task)) threadPool->wait(thread->task);
+		}
+		if (embeddedPreviewTask) {
+			*embeddedPreviewCancellation = true;
+			abandonedTasks.append(embeddedPreviewTask);
+		}
+		for (ThreadPool::TaskHandle const& task : abandonedTasks) {
+			if (!threadPool->cancel(task)) threadPool->wait(task);
+		}
+		delete imageView;
+		delete slideshowDialog;
+		delete sharpeningDialog;
+		delete performanceDialog;
+		delete fileMenu;
+		delete viewMenu;
+		delete slideshowMenu;
+		delete applicationMenu;
+		delete quitAction;
+		delete openAction;
+		delete refreshAction;
+		delete resetSettingsAction;
+		delete showInfoAction;
+		delete smoothingAction;
+		delete enlargementAction;
+		delete sharpeningAction;
+		delete sharpeningOptionsAction;
+		delete menuBarAutoHideAction;
+		delete slideshowAction;
+		delete slideshowNoDialogAction;
+		delete zoomLevelAction;
+		delete installAction;
+		delete uninstallAction;
+		delete mouseHideTimer;
+		delete threadCleanUpTimer;
+		delete slideshowTimer;
+	}
+
+	QSize MainInterface::sizeHint() const {
+		return settings->value("windowSize", QSize(900, 600)).toSize();
+		//return QSize(900, 600);
+	}
+
+	//============================================================================== PROTECTED ==============================================================================\\
+
+	bool MainInterface::eventFilter(QObject* object, QEvent* e) {
+		if (e->type() == QEvent::MouseButtonRelease) {
+			QMouseEvent* keyEvent = (QMouseEvent*)e;
+			mouseReleaseEvent(keyEvent);
+		} else if (e->type() == QEvent::Wheel) {
+			if (menuBar()->isVisible()) {
+				hideMenuBar();
+			}
+		} else if (e->type() == QEvent::MouseMove) {
+			QMouseEvent* keyEvent = (QMouseEvent*)e;
+			mouseMoveEvent(keyEvent);
+		}
+		return false;
+	}
+
+	void MainInterface::dragEnterEvent(QDragEnterEvent* e) {
+		if (e->mimeData()->hasUrls()) {
+			if (!e->mimeData()->urls().isEmpty() && QFileInfo(e->mimeData()->urls().first().toLocalFile()).isFile()) {
+				e->acceptProposedAction();
+			}
+		}
+	}
+
+	void MainInterface::dropEvent(QDropEvent* e) {
+		if (!e->mimeData()->urls().isEmpty()) {
+			if (e->mimeData()->urls().size() == 1) {
+				QString path = e->mimeData()->urls().first().toLocalFile();
+				loadImage(path);
+			} else {
+				QStringList paths;
+				for (QUrl& url : e->mimeData()->urls()) {
+					paths.append(url.toLocalFile());
+				}
+				loadImages(paths);
+			}
+		}
+	}
+
+	void MainInterface::keyPressEvent(QKeyEvent* e) {
+		if (e->modifiers() == (Qt::ControlModifier | Qt::ShiftModifier)) {
+			if (e->key() == Qt::Key_Right) {
+				changeFontSizeBy(1);
+				e->accept();
+			} else if (e->key() == Qt::Key_Left) {
+				changeFontSizeBy(-1);
+				e->accept();
+			} else if (e->key() == Qt::Key_Up) {
+				changeLineSpacingBy(1);
+				e->accept();
+			} else if (e->key() == Qt::Key_Down) {
+				changeLineSpacingBy(-1);
+				e->accept();
+			}
+		} else if (e->key() == Qt::Key_Right || e->key() == Qt::Key_Down) {
+			loadNextImage();
+			e->accept();
+		} else if (e->key() == Qt::Key_Left || e->key() == Qt::Key_Up) {
+			loadPreviousImage();
+			e->accept();
+		} else if (e->key() == Qt::Key_Escape) {
+			if (menuBar()->isVisible()) {
+				hideMenuBar();
+			} else if (isFullScreen()) {
+				exitFullscreen();
+			}
+		} else {
+			e->ignore();
+		}
+	}
+
+	void MainInterface::keyReleaseEvent(QKeyEvent* e) {
+		if (e->key() == Qt::Key_Alt && !skipNextAltRelease) {
+			if (!menuBar()->isVisible()){
+				showMenuBar();
+				e->accept();
+			} else {
+				hideMenuBar();
+				e->ignore();
+			}
+		}
+		if (e->key() == Qt::Key_Alt) {
+			skipNextAltRelease = false;
+		}
+	}
+
+	void MainInterface::mouseDoubleClickEvent(QMouseEvent* e) {
+		if (e->button() == Qt::LeftButton) {
+			toggleFullscreen();
+			e->accept();
+		}
+	}
+
+	void MainInterface::mouseReleaseEvent(QMouseEvent* e) {
+		if (e->button() == Qt::ForwardButton) loadNextImage();
+		if (e->button() == Qt::BackButton) loadPreviousImage();
+		if (menuBar()->isVisible()) {
+			hideMenuBar();
+		}
+	}
+
+	void MainInterface::mouseMoveEvent(QMouseEvent* e) {
+		if (isFullScreen()) {
+			showMouse();
+			enableAutomaticMouseHide();
+		}
+		e->ignore();
+	}
+
+	void MainInterface::changeEvent(QEvent* e) {
+		if (e->type() == QEvent::WindowStateChange) {
+			if (!isMinimized() && !isFullScreen()) {
+				settings->setValue("maximized", isMaximized());
+				saveSizeAction->setEnabled(!isMaximized());
+			} else if (isFullScreen()) {
+				QWindowStateChangeEvent* windowStateChangeEvent = static_cast<QWindowStateChangeEvent*>(e);
+				settings->setValue("maximized", bool(windowStateChangeEvent->oldState() & Qt::WindowMaximized));
+				saveSizeAction->setEnabled(false);
+			}
+		}
+	}
+
+	void MainInterface::wheelEvent(QWheelEvent * e) {
+		if (e->modifiers() == Qt::ShiftModifier) {
+			if (e->angleDelta().y() > 0) {
+				userRotation -= 10;
+				imageView->rotateBy(-10);
+			} else if (e->angleDelta().y() < 0) {
+				userRotation += 10;
+				imageView->rotateBy(10);
+			}
+		}
+	}
+
+	//=============================================================================== PRIVATE ===============================================================================\\
+
+	void MainInterface::initialize() {
+		//a few decodes in parallel keep the prefetching ahead, more would only compete for cores and disk bandwidth;
+		//the view computes its resizes and tiles on the same pool, ranked before the prefetches
+		threadPool = std::shared_ptr<ThreadPool>(new ThreadPool(std::clamp(std::thread::hardware_concurrency() / 2, 2u, 4u)));
+		prefetchPlanner.setThreadCount(threadPool->threadCount());
+		setAcceptDrops(true);
+		qRegisterMetaType<Image>("Image");
+		QObject::connect(this, SIGNAL(readImageFinished(QString, Image)), this, SLOT(reactToReadImageCompletion(QString, Image)), Qt::QueuedConnection);
+		QObject::connect(this, SIGNAL(embeddedPreviewFinished(QString, Image)), this, SLOT(reactToEmbeddedPreviewCompletion(QString, Image)), Qt::QueuedConnection);
+		setWindowTitle(programTitle);
+
+		directoryModel = new DirectoryModel(threadPool, DirectoryListingPriority, this);
+		QObject::connect(directoryModel, SIGNAL(listingFinished()), this, SLOT(reactToDirectoryListing()));
+		QObject::connect(directoryModel, SIGNAL(fileAdded(QString, int)), this, SLOT(reactToFileAddition(QString, int)));
+		QObject::connect(directoryModel, SIGNAL(fileRemoved(QString, int)), this, SLOT(reactToFileRemoval(QString, int)));
+		metadataIndex = new MetadataIndex(threadPool, IndexingPriority, this);
+
+		hb::ImageView::ImageOperations imageOperations;
+		imageOperations.resize = downscaling::resize;
+		imageOperations.resizeSharpened = downscaling::areaDownscaleSharpened;
+		imageOperations.toPremultipliedBgra = conversion::toPremultipliedBgra;
+		//visible tiles are needed as urgently as the current image, pyramid levels only speed up later zooming
+		imageView = new hb::ImageView(this, std::make_shared<ViewWorkerPool>(threadPool, CurrentImagePriority, PrefetchPriority), imageOperations);
+		//decides per scaling factor which downscaler is faster with the OpenCV build at hand; timing it while images are decoded would skew the result
+		threadPool->enqueue([]() { downscaling::calibrate(); }, IndexingPriority + 1);
+		imageView->setShowInterfaceOutline(false);
+		imageView->setUseSmoothTransform(false);
+		imageView->installEventFilter(this);
+		imageView->setExternalPostPaintFunction(this, &MainInterface::infoPaintFunction);
+		QObject::connect(imageView, SIGNAL(magnificationChanged()), this, SLOT(updateDecodeResolution()));
+		imageView->setInterfaceBackgroundColor(Qt::black);
+		imageView->setPreventMagnificationInDefaultZoom(true);
+		imageView->setUseGpu(true);
+		imageView->setPostResizeSharpening(false, settings->value("sharpeningStrength", 0.5).toDouble(), settings->value("sharpeningRadius", 0.5).toDouble());
+		setCentralWidget(imageView);
+
+		slideshowDialog = new SlideshowDialog(settings, this);
+		slideshowDialog->setWindowModality(Qt::WindowModal);
+		QObject::connect(slideshowDialog, &SlideshowDialog::accepted, this, &MainInterface::startSlideshow);
+		QObject::connect(slideshowDialog, SIGNAL(finished(int)), this, SLOT(enableAutomaticMouseHide()));
+
+		sharpeningDialog = new SharpeningDialog(settings, this);
+		QObject::connect(sharpeningDialog, SIGNAL(sharpeningParametersChanged()), this, SLOT(updateSharpening()));
+		QObject::connect(sharpeningDialog, SIGNAL(finished(int)), this, SLOT(enableAutomaticMouseHide()));
+
+		performanceDialog = new PerformanceDialog(settings, this);
+		performanceDialog->setWindowModality(Qt::WindowModal);
+		QObject::connect(performanceDialog, SIGNAL(performanceSettingsChanged()), this, SLOT(updatePerformanceSettings()));
+		QObject::connect(performanceDialog, SIGNAL(finished(int)), this, SLOT(enableAutomaticMouseHide()));
+
+		hotkeyDialog = new HotkeyDialog(settings, this);
+		hotkeyDialog->setWindowModality(Qt::WindowModal);
+		QObject::connect(hotkeyDialog, SIGNAL(finished(int)), this, SLOT(enableAutomaticMouseHide()));
+		QObject::connect(hotkeyDialog, SIGNAL(finished(int)), this, SLOT(updateCustomHotkeys()));
+
+		aboutDialog = new AboutDialog(settings, this);
+		aboutDialog->setWindowModality(Qt::WindowModal);
+
+		QObject::connect(menuBar(), SIGNAL(triggered(QAction*)), this, SLOT(hideMenuBar(QAction*)));
+		fileMenu = menuBar()->addMenu(tr("&File"));
+		viewMenu = menuBar()->addMenu(tr("&View"));
+		zoomMenu = menuBar()->addMenu(tr("&Zoom"));
+		rotationMenu = menuBar()->addMenu(tr("&Rotation"));
+		sharpeningMenu = menuBar()->addMenu(tr("&Sharpening"));
+		slideshowMenu = menuBar()->addMenu(tr("S&lideshow"));
+
+		applicationMenu = menuBar()->addMenu(tr("&Application"));
+#ifdef Q_OS_WIN
+		QObject::connect(applicationMenu, SIGNAL(aboutToShow()), this, SLOT(populateApplicationMenu()));
+		installAction = new QAction(tr("&Install"), this);
+		QObject::connect(installAction, SIGNAL(triggered()), this, SLOT(runInstaller()));
+		uninstallAction = new QAction(tr("&Uninstall"), this);
+		QObject::connect(uninstallAction, SIGNAL(triggered()), this, SLOT(runUninstaller()));
+#endif
+
+		aboutAction = new QAction(tr("&About"), this);
+		aboutAction->setShortcut(Qt::Key_F1);
+		aboutAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(aboutAction, SIGNAL(triggered()), aboutDialog, SLOT(show()));
+		applicationMenu->addAction(aboutAction);
+		addAction(aboutAction);
+
+		openAction = new QAction(tr("&Open File"), this);
+		openAction->setShortcut(QKeySequence::Open);
+		openAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(openAction, SIGNAL(triggered()), this, SLOT(openDialog()));
+		fileMenu->addAction(openAction);
+		addAction(openAction);
+
+		refreshAction = new QAction(tr("&Refresh"), this);
+		refreshAction->setEnabled(false);
+		refreshAction->setShortcut(Qt::Key_F5);
+		refreshAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(refreshAction, SIGNAL(triggered()), this, SLOT(refresh()));
+		fileMenu->addAction(refreshAction);
+		addAction(refreshAction);
+
+		fileMenu->addSeparator();
+
+		fileActionAction = new QAction(tr("&Enable File Action Hotkeys"), this);
+		fileActionAction->setCheckable(true);
+		fileActionAction->setChecked(false);
+		fileActionAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_H));
+		fileActionAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(fileActionAction, SIGNAL(triggered(bool)), hotkeyDialog, SLOT(setHotkeysEnabled(bool)));
+		fileMenu->addAction(fileActionAction);
+		addAction(fileActionAction);
+
+		hotkeyOptionsAction = new QAction(tr("&Hotkey Options..."), this);
+		hotkeyOptionsAction->setShortcut(QKeyCombination(Qt::CTRL | Qt::SHIFT, Qt::Key_O));
+		hotkeyOptionsAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(hotkeyOptionsAction, SIGNAL(triggered()), this, SLOT(showHotkeyDialog()));
+		fileMenu->addAction(hotkeyOptionsAction);
+		addAction(hotkeyOptionsAction);
+
+		fileMenu->addSeparator();
+
+		includePartiallySupportedFilesAction = new QAction(tr("&Include Preview-Only Files in Directory List"), this);
+		includePartiallySupportedFilesAction->setCheckable(true);
+		includePartiallySupportedFilesAction->setChecked(true);
+		includePartiallySupportedFilesAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_P));
+		includePartiallySupportedFilesAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(includePartiallySupportedFilesAction, SIGNAL(triggered(bool)), this, SLOT(togglePreviewOnlyFiles(bool)));
+		fileMenu->addAction(includePartiallySupportedFilesAction);
+		addAction(includePartiallySupportedFilesAction);
+
+		fileMenu->addSeparator();
+
+		resetSettingsAction = new QAction(tr("&Reset All Settings to Default"), this);
+		QObject::connect(resetSettingsAction, SIGNAL(triggered()), this, SLOT(resetSettings()));
+		fileMenu->addAction(resetSettingsAction);
+
+		fileMenu->addSeparator();
+
+		quitAction = new QAction(tr("&Quit"), this);
+		quitAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_Q));
+		quitAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(quitAction, SIGNAL(triggered()), this, SLOT(quit()));
+		fileMenu->addAction(quitAction);
+		//so shortcuts also work when menu bar is not visible
+		addAction(quitAction);
+
+		showInfoAction = new QAction(tr("Show &Info Overlay"), this);
+		showInfoAction->setCheckable(true);
+		showInfoAction->setChecked(false);
+		showInfoAction->setShortcut(Qt::Key_I);
+		showInfoAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(showInfoAction, SIGNAL(triggered(bool)), this, SLOT(toggleInfoOverlay(bool)));
+		viewMenu->addAction(showInfoAction);
+		addAction(showInfoAction);
+
+		zoomLevelAction = new QAction(tr("Show &Zoom Level Overlay"), this);
+		zoomLevelAction->setCheckable(true);
+		zoomLevelAction->setChecked(false);
+		zoomLevelAction->setShortcut(Qt::Key_Z);
+		zoomLevelAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(zoomLevelAction, SIGNAL(triggered(bool)), this, SLOT(toggleZoomLevelOverlay(bool)));
+		viewMenu->addAction(zoomLevelAction);
+		addAction(zoomLevelAction);
+
+		backgroundColorMenu = viewMenu->addMenu(tr("&Background Colour"));
+
+		backgroundColorBlackAction = new QAction(tr("&Black"), this);
+		backgroundColorBlackAction->setCheckable(true);
+		backgroundColorBlackAction->setChecked(false);
+		backgroundColorBlackAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_B));
+		backgroundColorBlackAction->setShortcutContext(Qt::ApplicationShortcut);
+		backgroundColorMenu->addAction(backgroundColorBlackAction);
+		addAction(backgroundColorBlackAction);
+
+		backgroundColorGrayAction = new QAction(tr("Dark &Grey"), this);
+		backgroundColorGrayAction->setCheckable(true);
+		backgroundColorGrayAction->setChecked(false);
+		backgroundColorGrayAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_G));
+		backgroundColorGrayAction->setShortcutContext(Qt::ApplicationShortcut);
+		backgroundColorMenu->addAction(backgroundColorGrayAction);
+		addAction(backgroundColorGrayAction);
+
+		backgroundColorWhiteAction = new QAction(tr("&White"), this);
+		backgroundColorWhiteAction->setCheckable(true);
+		backgroundColorWhiteAction->setChecked(false);
+		backgroundColorWhiteAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_W));
+		backgroundColorWhiteAction->setShortcutContext(Qt::ApplicationShortcut);
+		backgroundColorMenu->addAction(backgroundColorWhiteAction);
+		addAction(backgroundColorWhiteAction);
+
+		backgroundColorCustomAction = new QAction(tr("&Custom"), this);
+		backgroundColorCustomAction->setCheckable(true);
+		backgroundColorCustomAction->setChecked(false);
+		backgroundColorCustomAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_C));
+		backgroundColorCustomAction->setShortcutContext(Qt::ApplicationShortcut);
+		backgroundColorMenu->addAction(backgroundColorCustomAction);
+		addAction(backgroundColorCustomAction);
+
+		backgroundColorActionGroup = new QActionGroup(this);
+		backgroundColorActionGroup->addAction(backgroundColorBlackAction);
+		backgroundColorActionGroup->addAction(backgroundColorGrayAction);
+		backgroundColorActionGroup->addAction(backgroundColorWhiteAction);
+		backgroundColorActionGroup->addAction(backgroundColorCustomAction);
+		backgroundColorActionGroup->setExclusive(true);
+		QObject::connect(backgroundColorActionGroup, SIGNAL(triggered(QAction*)), this, SLOT(changeBackgroundColor(QAction*)));
+
+		viewMenu->addSeparator();
+
+		fullscreenAction = new QAction(tr("&Fullscreen"), this);
+		fullscreenAction->setCheckable(true);
+		fullscreenAction->setChecked(false);
+		fullscreenAction->setShortcut(Qt::Key_F);
+		fullscreenAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(fullscreenAction, SIGNAL(triggered(bool)), this, SLOT(toggleFullscreen()));
+		viewMenu->addAction(fullscreenAction);
+		addAction(fullscreenAction);
+
+		viewMenu->addSeparator();
+
+		menuBarAutoHideAction = new QAction(tr("&Always Show Menu Bar"), this);
+		menuBarAutoHideAction->setCheckable(true);
+		menuBarAutoHideAction->setChecked(false);
+		menuBarAutoHideAction->setShortcut(Qt::Key_M);
+		menuBarAutoHideAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(menuBarAutoHideAction, SIGNAL(triggered(bool)), this, SLOT(toggleMenuBarAutoHide(bool)));
+		viewMenu->addAction(menuBarAutoHideAction);
+		addAction(menuBarAutoHideAction);
+
+		viewMenu->addSeparator();
+
+		gpuAction = new QAction(tr("&Use GPU Acceleration"), this);
+		gpuAction->setCheckable(true);
+		gpuAction->setChecked(imageView->getUseGpu());
+		QObject::connect(gpuAction, SIGNAL(triggered(bool)), this, SLOT(toggleGpu(bool)));
+		viewMenu->addAction(gpuAction);
+
+		performanceOptionsAction = new QAction(tr("&Performance Options..."), this);
+		QObject::connect(performanceOptionsAction, SIGNAL(triggered()), this, SLOT(showPerformanceOptions()));
+		viewMenu->addAction(performanceOptionsAction);
+
+		viewMenu->addSeparator();
+
+		saveSizeAction = new QAction(tr("&Save Current Window Size and Position as Default"), this);
+		QObject::connect(saveSizeAction, SIGNAL(triggered(bool)), this, SLOT(saveWindowSize()));
+		viewMenu->addAction(saveSizeAction);
+
+		enlargementAction = new QAction(tr("&Enlarge Smaller Images to Fit Window"), this);
+		enlargementAction->setCheckable(true);
+		enlargementAction->setChecked(false);
+		enlargementAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_U));
+		enlargementAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(enlargementAction, SIGNAL(triggered(bool)), this, SLOT(toggleSmallImageUpscaling(bool)));
+		zoomMenu->addAction(enlargementAction);
+		addAction(enlargementAction);
+
+		smoothingAction = new QAction(tr("Use &Smooth Interpolation when Enlarging"), this);
+		smoothingAction->setCheckable(true);
+		smoothingAction->setChecked(false);
+		smoothingAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_S));
+		smoothingAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(smoothingAction, SIGNAL(triggered(bool)), this, SLOT(toggleEnglargmentInterpolationMethod(bool)));
+		zoomMenu->addAction(smoothingAction);
+		addAction(smoothingAction);
+
+		zoomMenu->addSeparator();
+
+		zoomToFitAction = new QAction(tr("Zoom to &Fit"), this);
+		zoomToFitAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_0));
+		zoomToFitAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(zoomToFitAction, SIGNAL(triggered(bool)), imageView, SLOT(resetZoom()));
+		zoomMenu->addAction(zoomToFitAction);
+		addAction(zoomToFitAction);
+
+		zoomTo100Action = new QAction(tr("Zoom to &100%"), this);
+		zoomTo100Action->setShortcut(QKeyCombination(Qt::CTRL | Qt::ALT, Qt::Key_0));
+		zoomTo100Action->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(zoomTo100Action, SIGNAL(triggered(bool)), this, SLOT(zoomTo100()));
+		zoomMenu->addAction(zoomTo100Action);
+		addAction(zoomTo100Action);
+
+		rotateLeftAction = new QAction(tr("Rotate View &Left"), this);
+		rotateLeftAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_Left));
+		rotateLeftAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(rotateLeftAction, SIGNAL(triggered(bool)), this, SLOT(rotateLeft()));
+		rotationMenu->addAction(rotateLeftAction);
+		addAction(rotateLeftAction);
+
+		rotateRightAction = new QAction(tr("Rotate &View Right"), this);
+		rotateRightAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_Right));
+		rotateRightAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(rotateRightAction, SIGNAL(triggered(bool)), this, SLOT(rotateRight()));
+		rotationMenu->addAction(rotateRightAction);
+		addAction(rotateRightAction);
+
+		resetRotationAction = new QAction(tr("&Reset Rotation"), this);
+		resetRotationAction->setShortcut(QKeyCombination(Qt::SHIFT, Qt::Key_Escape));
+		resetRotationAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(resetRotationAction, SIGNAL(triggered(bool)), this, SLOT(resetRotation()));
+		rotationMenu->addAction(resetRotationAction);
+		addAction(resetRotationAction);
+
+		rotationMenu->addSeparator();
+
+		autoRotationAction = new QAction(tr("&Automatic EXIF-based rotation"), this);
+		autoRotationAction->setCheckable(true);
+		autoRotationAction->setChecked(true);
+		autoRotationAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_R));
+		autoRotationAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(autoRotationAction, SIGNAL(triggered(bool)), this, SLOT(toggleAutoRotation(bool)));
+		rotationMenu->addAction(autoRotationAction);
+		addAction(autoRotationAction);
+
+		sharpeningAction = new QAction(tr("&Sharpen Images After Downsampling"), this);
+		sharpeningAction->setCheckable(true);
+		sharpeningAction->setChecked(false);
+		sharpeningAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_E));
+		sharpeningAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(sharpeningAction, SIGNAL(triggered(bool)), this, SLOT(toggleSharpening(bool)));
+		sharpeningMenu->addAction(sharpeningAction);
+		addAction(sharpeningAction);
+
+		sharpeningOptionsAction = new QAction(tr("Sharpening &Options..."), this);
+		sharpeningOptionsAction->setShortcut(Qt::Key_O);
+		sharpeningOptionsAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(sharpeningOptionsAction, SIGNAL(triggered(bool)), this, SLOT(showSharpeningOptions()));
+		sharpeningMenu->addAction(sharpeningOptionsAction);
+		addAction(sharpeningOptionsAction);
+
+		slideshowAction = new QAction(tr("&Start Slideshow"), this);
+		slideshowAction->setEnabled(false);
+		slideshowAction->setShortcut(QKeyCombination(Qt::CTRL, Qt::Key_Space));
+		slideshowAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(slideshowAction, SIGNAL(triggered()), this, SLOT(toggleSlideshow()));
+		slideshowMenu->addAction(slideshowAction);
+		addAction(slideshowAction);
+
+		slideshowNoDialogAction = new QAction(this);
+		slideshowNoDialogAction->setEnabled(false);
+		slideshowNoDialogAction->setShortcut(Qt::Key_Space);
+		slideshowNoDialogAction->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(slideshowNoDialogAction, SIGNAL(triggered()), this, SLOT(toggleSlideshowNoDialog()));
+		addAction(slideshowNoDialogAction);
+
+		customAction1 = new QAction(this);
+		customAction1->setEnabled(hotkeyDialog->getHotkey1Enabled() && hotkeyDialog->getHotkeysEnabled());
+		customAction1->setShortcut(hotkeyDialog->getKeySequence1());
+		customAction1->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(customAction1, SIGNAL(triggered()), this, SLOT(triggerCustomAction1()));
+		addAction(customAction1);
+
+		customAction2 = new QAction(this);
+		customAction2->setEnabled(hotkeyDialog->getHotkey2Enabled() && hotkeyDialog->getHotkeysEnabled());
+		customAction2->setShortcut(hotkeyDialog->getKeySequence2());
+		customAction2->setShortcutContext(Qt::ApplicationShortcut);
+		QObject::connect(customAction2, SIGNAL(triggered()), this, SLOT(triggerCustomAction2()));
+		addAction(customAction2);
+
+		//mouse hide timer in fullscreen
+		mouseHideTimer = new QTimer(this);
+		QObject::connect(mouseHideTimer, SIGNAL(timeout()), this, SLOT(hideMouse()));
+
+		//timer for thread cleanup
+		threadCleanUpTimer = new QTimer(this);
+		threadCleanUpTimer->setSingleShot(true);
+		QObject::connect(threadCleanUpTimer, SIGNAL(timeout()), this, SLOT(cleanUpThreads()));
+
+		//timer for the slideshow
+		slideshowTimer = new QTimer(this);
+		QObject::connect(slideshowTimer, SIGNAL(timeout()), this, SLOT(nextSlide()));
+
+		//load settings
+		loadSettings();
+		if (settings->contains("windowPosition")) {
+			move(settings->value("windowPosition", QPoint(10, 10)).toPoint());
+		}
+		if (settings->contains("windowSize")) {
+			resize(settings->value("windowSize", QSize(900, 600)).toSize());
+		}
+		if (settings->value("maximized", false).toBool()) {
+			showMaximized();
+		}
+	}
+
+	std::shared_future<Image> MainInterface::currentThread() {
+		ImageThread* thread = imageCache.find(currentThreadName);
+		if (thread == nullptr) return std::shared_future<Image>();
+		return thread->future;
+	}
+
+	bool MainInterface::exifIsRequired() const {
+		return showInfoAction->isChecked() || autoRotationAction->isChecked();
+	}
+
+	///Decodes the image at \p path; if \p cancellation is set in the meantime, gives up at the next stage and returns an invalid image.
+	/**
+	 * If \p targetSize is valid and the image is a JPEG that is displayed at less than half its
+	 * size in a viewport of that size, it is decoded at a reduced resolution.
+	 */
+	Image MainInterface::readImage(QString path, ThreadPool::CancellationToken cancellation, QSize targetSize) {
+		auto isCancelled = [&]() {
+			if (!*cancellation) return false;
+			++abortedDecodeCount;
+			return true;
+		};
+		try {
+			std::chrono::steady_clock::time_point decodeStart = std::chrono::steady_clock::now();
+			cv::Mat image;
+			bool isPreviewImage = false;
+			Image result;
+			std::shared_ptr<ExifData> exifData;
+			//for the images we know are not supported by opencv do not attempt to read them with opencv
+			bool forcePreview = partiallySupportedExtensions.contains(QString("*.") + QFileInfo(path).suffix().toLower());
+			if (isCancelled()) return Image();
+			if (!forcePreview && tiledExtensions.contains(QFileInfo(path).suffix().toLower())) {
+				result = readTiledImage(path, cancellation);
+				if (isCancelled()) return Image();
+				if (result.isValid()) {
+					prefetchPlanner.registerDecode(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count(), result.byteSize());
+					return result;
+				}
+			}
+			//OpenCV and Qt address in-memory data with an int, larger files (e.g. uncompressed TIFFs) are decoded from the path
+			bool decodeFromPath = QFileInfo(path).size() > std::numeric_limits<int>::max();
+			//otherwise the file is read only once (and mapped if possible), the pixel decoder and Exiv2 both work on these bytes
+			std::shared_ptr<utility::FileBuffer> fileData = decodeFromPath ? nullptr : utility::mapFile(path);
+			if (isCancelled()) return Image();
+			bool hasData = decodeFromPath || !fileData->empty();
+			//the const cast is fine, the mat is only read from
+			cv::Mat encoded = decodeFromPath ? cv::Mat() : cv::Mat(1, int(fileData->size()), CV_8U, const_cast<char*>(fileData->data()));
+			auto decode = [&](int flags) {
+				if (decodeFromPath) return cv::imread(path.toLocal8Bit().constData(), flags);
+				return cv::imdecode(encoded, flags);
+			};
+			QSize encodedSize = forcePreview || !hasData ? QSize() : encodedImageSize(fileData.get(), path);
+			cv::Size fullSize = encodedSize.isValid() ? cv::Size(encodedSize.width(), encodedSize.height()) : cv::Size();
+			bool exceedsSizeLimit = encodedSize.isValid() && qint64(encodedSize.width()) * encodedSize.height() > maximumImagePixels;
+			int reduction = encodedSize.isValid() ? reducedDecodeFactor(path, targetSize, encodedSize) : 1;
+			//only a decode at the coarsest factor the size limit requires cannot be improved on by zooming in
+			bool atSizeLimit = exceedsSizeLimit && reduction >= reducedDecodeFactor(path, QSize(), encodedSize);
+			bool premultipliedSource = false;
+			if (reduction > 1) {
+				//the decoder scales in the DCT domain which is much faster than decoding everything; orientation is handled by the view
+				int flag = reduction == 8 ? cv::IMREAD_REDUCED_COLOR_8 : (reduction == 4 ? cv::IMREAD_REDUCED_COLOR_4 : cv::IMREAD_REDUCED_COLOR_2);
+				image = decode(flag | cv::IMREAD_IGNORE_ORIENTATION);
+				if (!image.data) reduction = 1;
+			}
+			if (exceedsSizeLimit && !image.data) {
+				image = readDownscaled(fileData.get(), path, encodedSize, cancellation, premultipliedSource);
+				if (isCancelled()) return Image();
+				if (image.data) reduction = std::max(2, int(std::ceil(double(encodedSize.width()) / image.cols)));
+				//scaled to the limit exactly
+				atSizeLimit = true;
+			}
+			//decoding an image beyond the size limit as a whole could exhaust the memory; if it cannot be read downscaled, only its embedded preview is shown
+			if (!forcePreview && hasData && !image.data && !exceedsSizeLimit) image = decode(cv::IMREAD_UNCHANGED);
+			if (isCancelled()) return Image();
+			if ((!exifIsRequired() && image.data) || decodeFromPath) {
+				//deferred loading only keeps the path, holding on to the file contents for metadata that might never be shown is too expensive
+				exifData = std::shared_ptr<ExifData>(new ExifData(path, threadPool, ExifPriority, true, cancellation));
+			} else {
+				exifData = std::shared_ptr<ExifData>(new ExifData(fileData, threadPool, ExifPriority, cancellation));
+			}
+			fileData.reset();
+			if (!image.data) {  
+				exifData->join();
+				if (isCancelled()) return Image();
+				if (exifData->hasPreviewImage()) {
+					image = exifData->largestReadablePreviewImage();
+					isPreviewImage = true;
+				}
+			}
+			if (image.data) {
+				QObject::connect(exifData.get(), SIGNAL(loadingFinished(ExifData*)), this, SLOT(reactToExifLoadingCompletion(ExifData*)));
+				//convert format; the channels stay in OpenCV's BGR order, the view displays them as they are
+				image = conversion::toEightBit(image, highBitDepthGamma);
+				//converting here on the decoding thread spares the GUI thread a conversion in every paint event
+				bool premultiplied = premultipliedSource || (convertForPainting && image.depth() == CV_8U);
+				if (premultiplied && !premultipliedSource) image = conversion::toPremultipliedBgra(image);
+				if (isCancelled()) return Image();
+				result = reduction > 1 ? Image(image, exifData, isPreviewImage, reduction, fullSize) : Image(image, exifData, isPreviewImage);
+				result.setAlphaPremultiplied(premultiplied);
+				result.setReducedToSizeLimit(atSizeLimit && !isPreviewImage);
+				prefetchPlanner.registerDecode(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count(), result.byteSize());
+			}
+			return result;
+		} catch (...) {
+			return Image();
+		}
+	}
+
+	///If the image at \p path is a tiled TIFF too large to be decoded as a whole, returns an overview that reads the tiles as needed; otherwise an invalid image.
+	Image MainInterface::readTiledImage(QString const& path, ThreadPool::CancellationToken cancellation) {
+		std::shared_ptr<TiffTileSource> tileSource = TiffTileSource::open(path);
+		if (!tileSource || tileSource->levelCount() == 0) return Image();
+		QSize fullSize = tileSource->levelSize(0);
+		if (qint64(fullSize.width()) * fullSize.height() < std::min(tiledDecodingThreshold, qint64(maximumImagePixels))) return Image();
+		cv::Mat overview = tileSource->overview(tiledOverviewSize, cancellation);
+		if (overview.empty()) return Image();
+		std::shared_ptr<ExifData> exifData(new ExifData(path, threadPool, ExifPriority, !exifIsRequired(), cancellation));
+		QObject::connect(exifData.get(), SIGNAL(loadingFinished(ExifData*)), this, SLOT(reactToExifLoadingCompletion(ExifData*)));
+		Image result(overview, exifData, false, 1, cv::Size(fullSize.width(), fullSize.height()));
+		result.setAlphaPremultiplied(true);
+		result.setTileSource(tileSource);
+		return result;
+	}
+
+	void MainInterface::loadNextImage() {
+		if (loading) return;
+		if (directoryModel->isListing()) {
+			//the neighbours are not known yet, the step is taken once they are
+			++pendingNavigationSteps;
+			return;
+		}
+		std::unique_lock<std::mutex> lock(threadDeletionMutex);
+		if (filesInDirectory.size() != 0) {
+			currentFileIndex = nextFileIndex();
+			currentThreadName = filesInDirectory[currentFileIndex];
+			prefetchPlanner.registerStep(true);
+			//request the current image with the highest priority and start loading the following ones
+			updateImageThreads();
+			currentFileInfo = QFileInfo(getFullImagePath(currentFileIndex));
+			lock.unlock();
+			showCurrentImage();
+		} else {
+			lock.unlock();
+		}
+		cleanUpThreads();
+	}
+
+	void MainInterface::loadPreviousImage() {
+		if (loading) return;
+		if (directoryModel->isListing()) {
+			--pendingNavigationSteps;
+			return;
+		}
+		std::unique_lock<std::mutex> lock(threadDeletionMutex);
+		if (filesInDirectory.size() != 0) {
+			currentFileIndex = previousFileIndex();
+			currentThreadName = filesInDirectory[currentFileIndex];
+			prefetchPlanner.registerStep(false);
+			//request the current image with the highest priority and start loading the preceding ones
+			updateImageThreads();
+			currentFileInfo = QFileInfo(getFullImagePath(currentFileIndex));
+			lock.unlock();
+			showCurrentImage();
+		} else {
+			lock.unlock();
+		}
+		cleanUpThreads();
+	}
+
+	///Displays the current image if it has already been decoded, otherwise it is displayed once \c readImageFinished arrives for it.
+	void MainInterface::showCurrentImage() {
+		waitingForFullResolution = false;
+		showingEmbeddedPreview = false;
+		std::shared_future<Image> thread = currentThread();
+		if (thread.valid() && thread.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
+			waitingForCurrentImage = false;
+			image = thread.get();
+			//calling this function although the exif might not be set to deferred loading is no problem (it checks internally)
+			if (exifIsRequired() && image.isValid()) image.exif()->startLoading();
+			statusHint = QString();
+			displayImageIfOk();
+		} else {
+			//keep showing the previous image until the embedded preview or the decode is done
+			waitingForCurrentImage = true;
+			if (directoryModel->isListing()) {
+				setWindowTitle(QString("%1 - %2").arg(currentFileInfo.fileName(), programTitle) + tr(" - Loading..."));
+			} else {
+				setWindowTitle(QString("%1 - %2 - %3 of %4").arg(currentFileInfo.fileName(),
+																	 programTitle).arg(currentFileIndex + 1).arg(filesInDirectory.size()) + tr(" - Loading..."));
+			}
+			launchEmbeddedPreview(currentFileInfo.absoluteFilePath());
+		}
+	}
+
+	///Starts extracting the preview embedded in the file at \p path so it can be shown while the image is decoded; a previous extraction is abandoned.
+	void MainInterface::launchEmbeddedPreview(QString const& path) {
+		if (embeddedPreviewTask) {
+			*embeddedPreviewCancellation = true;
+			if (!threadPool->cancel(embeddedPreviewTask) && !threadPool->isDone(embeddedPreviewTask)) abandonedTasks.append(embeddedPreviewTask);
+			embeddedPreviewTask.reset();
+		}
+		if (!embeddedPreviewExtensions.contains(QFileInfo(path).suffix().toLower())) return;
+		embeddedPreviewCancellation = ThreadPool::makeCancellationToken();
+		ThreadPool::CancellationToken cancellation = embeddedPreviewCancellation;
+		embeddedPreviewTask = threadPool->enqueue([this, path, cancellation]() { readEmbeddedPreview(path, cancellation); }, EmbeddedPreviewPriority);
+	}
+
+	///Extracts the largest embedded preview of the image at \p path and delivers it through \c embeddedPreviewFinished.
+	void MainInterface::readEmbeddedPreview(QString path, ThreadPool::CancellationToken cancellation) {
+		try {
+			std::shared_ptr<ExifData> exifData(new ExifData(path, threadPool, ExifPriority, false, cancellation));
+			exifData->join();
+			if (*cancellation || !exifData->hasPreviewImage()) return;
+			cv::Mat preview = exifData->largestReadablePreviewImage();
+			//the view needs the full resolution so that it does not change when the decode replaces the preview
+			QSize size = QImageReader(path).size();
+			cv::Size fullSize = size.isValid() ? cv::Size(size.width(), size.height()) : cv::Size();
+			if (*cancellation) return;
+			emit(embeddedPreviewFinished(QFileInfo(path).fileName(), Image(preview, exifData, true, 1, fullSize)));
+		} catch (...) { }
+	}
+
+	///Starts decoding the image at \p path unless it is already in the cache; \p fullResolution prevents a reduced decode beyond what the size limit requires.
+	void MainInterface::launchImageThread(QString const& path, int priority, bool fullResolution) {
+		QString filename = QFileInfo(path).fileName();
+		//bookkeeping only, the image is marked as used when it is shown
+		ImageThread* existing = imageCache.peek(filename);
+		if (existing != nullptr) {
+			//already loading or loaded, only adjust the priority in case it is still queued
+			threadPool->setPriority(existing->task, priority);
+			return;
+		}
+		ImageThread thread;
+		thread.cancellation = ThreadPool::makeCancellationToken();
+		std::shared_ptr<std::packaged_task<Image()>> job(new std::packaged_task<Image()>(std::bind(&MainInterface::readImage, this, path, thread.cancellation, fullResolution ? QSize() : decodeTargetSize())));
+		thread.future = job->get_future().share();
+		std::shared_future<Image> future = thread.future;
+		ThreadPool::CancellationToken cancellation = thread.cancellation;
+		thread.task = threadPool->enqueue([this, job, future, cancellation, filename]() {
+			(*job)();
+			//the result is delivered to the GUI thread through a queued connection; only now is the future ready, so the slot finds it ready as well
+			if (!*cancellation) emit(readImageFinished(filename, future.get()));
+		}, priority);
+		imageCache.insert(filename, thread);
+	}
+
+	///Prioritises the decodes of the prefetch window around the current image; queued decodes of other images are cancelled.
+	void MainInterface::updateImageThreads() {
+		if (filesInDirectory.size() == 0 || currentFileIndex < 0) return;
+		QVector<QPair<QString, int>> window = prefetchWindow();
+		QHash<QString, int> priorities;
+		for (QPair<QString, int> const& entry : window) {
+			priorities.insert(entry.first, entry.second);
+		}
+		for (QString const& key : imageCache.keys()) {
+			ImageThread* thread = imageCache.peek(key);
+			if (priorities.contains(key)) {
+				threadPool->setPriority(thread->task, priorities.value(key));
+			} else if (!threadPool->isDone(thread->task)) {
+				//still queued or decoding but no longer needed
+				abandonImageThread(key);
+			}
+		}
+		for (QPair<QString, int> const& entry : window) {
+			launchImageThread(currentDirectory.absoluteFilePath(entry.first), entry.second);
+		}
+	}
+
+	///Returns the size in device pixels that decoded images have to fill, or an invalid size if images must always be decoded at full resolution.
+	QSize MainInterface::decodeTargetSize() const {
+		if (!useReducedDecoding) return QSize();
+		return imageView->size() * imageView->devicePixelRatioF();
+	}
+
+	///Returns the resolution of the image in \p fileData, or in the file at \p path if it is null, by parsing only its header; an invalid size if it cannot be determined.
+	QSize MainInterface::encodedImageSize(utility::FileBuffer const* fileData, QString const& path) const {
+		if (tiledExtensions.contains(QFileInfo(path).suffix().toLower())) {
+			//Qt only reads TIFF headers with the qtimageformats plugin installed
+			QSize size = TiffTileSource::imageSize(path);
+			if (size.isValid()) return size;
+		}
+		QByteArray bytes;
+		QBuffer buffer(&bytes);
+		QFile file(path);
+		QIODevice* device = &file;
+		if (fileData) {
+			bytes = QByteArray::fromRawData(fileData->data(), int(fileData->size()));
+			device = &buffer;
+		}
+		if (!device->open(QIODevice::ReadOnly)) return QSize();
+		QSize size = QImageReader(device).size();
+		if (!size.isValid() || size.isEmpty()) return QSize();
+		return size;
+	}
+
+	///Returns by which factor (1, 2, 4 or 8) a JPEG image of \p imageSize can be reduced while decoding.
+	/**
+	 * If \p targetSize is valid the image still has to fill it; it may be rotated by 90 degrees when
+	 * it is displayed, so both orientations have to fit. Independently of that the image is reduced
+	 * until it is within the size limit. \p path is used to determine the format.
+	 */
+	int MainInterface::reducedDecodeFactor(QString const& path, QSize targetSize, QSize imageSize) const {
+		if (!reducibleExtensions.contains(QFileInfo(path).suffix().toLower())) return 1;
+		int minimumFactor = 1;
+		while (minimumFactor < 8 && qint64(imageSize.width() / minimumFactor) * (imageSize.height() / minimumFactor) > maximumImagePixels) {
+			minimumFactor *= 2;
+		}
+		if (!targetSize.isValid() || targetSize.isEmpty()) return minimumFactor;
+		double fit = std::min(double(targetSize.width()) / imageSize.width(), double(targetSize.height()) / imageSize.height());
+		double rotatedFit = std::min(double(targetSize.width()) / imageSize.height(), double(targetSize.height()) / imageSize.width());
+		double scale = std::max(fit, rotatedFit);
+		for (int factor : { 8, 4, 2 }) {
+			if (scale <= 1.0 / factor) return std::max(factor, minimumFactor);
+		}
+		return minimumFactor;
+	}
+
+	///Decodes an image that exceeds the size limit at a reduced resolution without ever holding its full resolution in memory.
+	/**
+	 * TIFF files are read strip by strip or tile by tile through libtiff, other formats line by line
+	 * if their Qt image plugin can scale while decoding (e.g. PNG). Returns an empty mat if neither is possible.
+	 * The file is read from \p fileData, or from \p path if it is null.
+	 * \p premultiplied is set if the result is four channel BGRA with premultiplied alpha.
+	 */
+	cv::Mat MainInterface::readDownscaled(utility::FileBuffer const* fileData, QString const& path, QSize imageSize, ThreadPool::CancellationToken cancellation, bool& premultiplied) const {
+		double scale = std::sqrt(double(maximumImagePixels) / (double(imageSize.width()) * double(imageSize.height())));
+		if (tiledExtensions.contains(QFileInfo(path).suffix().toLower())) {
+			premultiplied = true;
+			std::shared_ptr<TiffTileSource> tileSource = TiffTileSource::open(path);
+			if (tileSource) return tileSource->overview(int(std::max(imageSize.width(), imageSize.height()) * scale), cancellation);
+			return TiffTileSource::readStripsReduced(path, int(std::ceil(1.0 / scale)), cancellation);
+		}
+		premultiplied = false;
+		QByteArray bytes;
+		QBuffer buffer(&bytes);
+		QFile file(path);
+		QIODevice* device = &file;
+		if (fileData) {
+			bytes = QByteArray::fromRawData(fileData->data(), int(fileData->size()));
+			device = &buffer;
+		}
+		if (!device->open(QIODevice::ReadOnly)) return cv::Mat();
+		QImageReader reader(device);
+		//Qt would otherwise emulate the scaling by decoding everything first
+		if (!reader.supportsOption(QImageIOHandler::ScaledSize)) return cv::Mat();
+		reader.setScaledSize(QSize(std::max(1, int(imageSize.width() * scale)), std::max(1, int(imageSize.height() * scale))));
+		QImage decoded = reader.read();
+		if (decoded.isNull()) return cv::Mat();
+		cv::Mat result;
+		if (decoded.isGrayscale()) {
+			decoded = decoded.convertToFormat(QImage::Format_Grayscale8);
+			result = cv::Mat(decoded.height(), decoded.width(), CV_8UC1, decoded.bits(), decoded.bytesPerLine()).clone();
+		} else if (decoded.hasAlphaChannel()) {
+			decoded = decoded.convertToFormat(QImage::Format_ARGB32);
+			result = cv::Mat(decoded.height(), decoded.width(), CV_8UC4, decoded.bits(), decoded.bytesPerLine()).clone();
+		} else {
+			decoded = decoded.convertToFormat(QImage::Format_BGR888);
+			result = cv::Mat(decoded.height(), decoded.width(), CV_8UC3, decoded.bits(), decoded.bytesPerLine()).clone();
+		}
+		return result;
+	}
+
+	///Returns the images that should be decoded around the current one, ordered by priority.
+	/**
+	 * The depth of the window in and against the direction of travel is determined by the
+	 * \c PrefetchPlanner. Closer images get a higher priority (lower value), at equal distance
+	 * the image ahead is preferred over the one behind.
+	 */
+	QVector<QPair<QString, int>> MainInterface::prefetchWindow() const {
+		QVector<QPair<QString, int>> window;
+		if (filesInDirectory.size() == 0 || currentFileIndex < 0 || currentFileIndex >= filesInDirectory.size()) return window;
+		QSet<FileList::FileId> added;
+		auto add = [&](size_t index, int priority) {
+			FileList::FileId id = filesInDirectory.id(int(index));
+			//in small folders the window can wrap around onto itself
+			if (added.contains(id)) return;
+			added.insert(id);
+			window.append(qMakePair(filesInDirectory[int(index)], priority));
+		};
+		add(currentFileIndex, CurrentImagePriority);
+		int ahead = prefetchPlanner.aheadDepth();
+		int behind = prefetchPlanner.behindDepth();
+		long direction = prefetchPlanner.isTravelingForward() ? 1 : -1;
+		for (int distance = 1; distance <= std::max(ahead, behind); ++distance) {
+			if (distance <= ahead) add(fileIndexAt(direction * distance), PrefetchPriority + 2 * (distance - 1));
+			if (distance <= behind) add(fileIndexAt(-direction * distance), PrefetchPriority + 2 * (distance - 1) + 1);
+		}
+		return window;
+	}
+
+	///Drops the decode of \p key from the cache; a queued decode is cancelled, a running one is told to stop at its next stage.
+	void MainInterface::abandonImageThread(QString const& key) {
+		ImageThread* thread = imageCache.peek(key);
+		if (thread == nullptr) return;
+		if (threadPool->cancel(thread->task)) {
+			++skippedDecodeCount;
+		} else if (!threadPool->isDone(thread->task)) {
+			*thread->cancellation = true;
+			abandonedTasks.append(thread->task);
+		}
+		imageCache.remove(key);
+	}
+
+	void MainInterface::clearThreads() {
+		for (QString const& key : imageCache.keys()) {
+			abandonImageThread(key);
+		}
+		imageCache.clear();
+	}
+
+	size_t MainInterface::nextFileIndex() const {
+		if (filesInDirectory.size() <= 0) return -1;
+		return (currentFileIndex + 1) % filesInDirectory.size();
+	}
+
+	size_t MainInterface::previousFileIndex() const {
+		if (filesInDirectory.size() <= 0) return -1;
+		if (currentFileIndex <= 0) return filesInDirectory.size() - 1;
+		return (currentFileIndex - 1) % filesInDirectory.size();
+	}
+
+	///Returns the index of the file \p offset positions away from the current one, wrapping around at the ends.
+	size_t MainInterface::fileIndexAt(long offset) const {
+		if (filesInDirectory.size() <= 0) return -1;
+		long count = filesInDirectory.size();
+		return size_t((((currentFileIndex + offset) % count) + count) % count);
+	}
+
+	void MainInterface::removeCurrentImageFromList(bool includeSidecarFiles, bool onlyXmp) {
+		std::unique_lock<std::mutex> lock(threadDeletionMutex);
+
+		if (filesInDirectory.size() != 0) {
+			QFileInfo imageInfo = QFileInfo(filesInDirectory[currentFileIndex]);
+			QString baseName = imageInfo.baseName();
+			QString extension = imageInfo.suffix().toLower();
+			//remove current file from directory list
+			directoryModel->removeFile(filesInDirectory[currentFileIndex]);
+			filesInDirectory.remove(currentFileIndex);
+
+			//remove sidecar files from directory list
+			if (includeSidecarFiles) {
+				//the base name index yields the candidates directly instead of examining every file
+				QStringList sidecars;
+				for (int i : filesInDirectory.indicesOfBaseName(baseName)) {
+					QFileInfo fileInfo(filesInDirectory[i]);
+					if (!onlyXmp || (fileInfo.suffix().toLower() == "xmp" && supportedRawFormats.contains(extension))) {
+						sidecars.append(filesInDirectory[i]);
+					}
+				}
+				for (QString const& sidecar : sidecars) {
+					int i = filesInDirectory.indexOf(sidecar);
+					directoryModel->removeFile(sidecar);
+					filesInDirectory.remove(i);
+					//correct the index shift
+					if (i < currentFileIndex) --currentFileIndex;
+				}
+			}
+
+			//if there are no images left, quit
+			if (filesInDirectory.size() <= 0) {
+				currentFileIndex = -1;
+				lock.unlock();
+				cleanUpThreads();
+				reset();
+				return;
+			}
+			//update current file index and related variables
+			if (currentFileIndex >= filesInDirectory.size()) currentFileIndex = filesInDirectory.size() - 1;
+			currentThreadName = filesInDirectory[currentFileIndex];
+
+			//load the image that is now the current one and the ones around it
+			updateImageThreads();
+			currentFileInfo = QFileInfo(getFullImagePath(currentFileIndex));
+			lock.unlock();
+			showCurrentImage();
+		} else {
+			lock.unlock();
+		}
+		cleanUpThreads();
+	}
+
+	void MainInterface::reset() {
+		imageView->resetImage();
+		image = sv::Image();
+		filesInDirectory.clear();
+		setWindowTitle(programTitle);
+	}
+
+	QString MainInterface::getFullImagePath(size_t index) const {
+		return currentDirectory.absoluteFilePath(filesInDirectory[index]);
+	}
+
+	void MainInterface::loadImage(QString path) {
+		if (loading) return;
+		std::unique_lock<std::mutex> lock(threadDeletionMutex);
+		//find the path in the current directory listing
+		QFileInfo fileInfo = QFileInfo(QDir::cleanPath(path));
+		QDir directory = fileInfo.absoluteDir();
+		QString filename = fileInfo.fileName();
+		currentDirectory = directory;
+		noCurrentDir = false;
+		QStringList filters = supportedExtensions;
+		filters << "*.bmp" << "*.dib" << "*.jpeg" << "*.jpg" << "*.jpe" << "*.jpeg" << "*.jp2" << "*.png" << "*.webp" << "*.pbm" << "*.pgm" << "*.ppm" << "*.sr" << "*.ras" << "*.tiff" << "*.tif";
+		if (includePartiallySupportedFilesAction->isChecked()) {
+			filters.append(partiallySupportedExtensions);
+		}
+		//the folder is only listed if it is not the one being watched already, which keeps its list current
+		pendingNavigationSteps = 0;
+		metadataIndex->setDirectory(directory);
+		if (directoryModel->setDirectory(directory, filters) || directoryModel->isListing()) {
+			//the folder is listed in the background, in the meantime the opened file is all there is and can be decoded right away
+			filesInDirectory.assign(QVector<QString>{ filename });
+			currentFileIndex = 0;
+		} else {
+			filesInDirectory.assign(directoryModel->files());
+			metadataIndex->prune(directoryModel->files());
+			metadataIndex->index(directoryModel->files());
+			if (filesInDirectory.size() == 0 || currentFileIndex < 0 || currentFileIndex >= filesInDirectory.size() || filesInDirectory.at(currentFileIndex) != filename) {
+				currentFileIndex = filesInDirectory.indexOf(filename);
+			}
+		}
+		currentThreadName = filename;
+		currentFileInfo = fileInfo;
+		prefetchPlanner.registerJump();
+		clearThreads();
+		launchImageThread(path, CurrentImagePriority);
+		updateImageThreads();
+		lock.unlock();
+		showCurrentImage();
+		if (waitingForCurrentImage) statusHint = tr("Loading...");
+		imageView->update();
+	}
+
+	void MainInterface::loadImages(QStringList paths) {
+		if (loading) return;
+		std::unique_lock<std::mutex> lock(threadDeletionMutex);
+		
+		QString path = paths.first();
+		//find the path in the current directory listing
+		QFileInfo fileInfo = QFileInfo(QDir::cleanPath(path));
+		QDir directory = fileInfo.absoluteDir();
+		QString filename = fileInfo.fileName();
+		currentDirectory = directory;
+		noCurrentDir = false;
+		//the selection is navigated instead of the folder, changes to the folder do not concern it
+		directoryModel->clear();
+		pendingNavigationSteps = 0;
+		//remove all images that are not in the same directory
+		QMutableListIterator<QString> it(paths);
+		while (it.hasNext()) {
+			if (QFileInfo(it.next()).absoluteDir() != currentDirectory) {
+				it.remove();
+			}
+		}
+		QVector<QString> names;
+		names.reserve(paths.size());
+		for (QString const& selectedPath : paths) {
+			names.append(QFileInfo(QDir::cleanPath(selectedPath)).fileName());
+		}
+		filesInDirectory.assign(names);
+		metadataIndex->setDirectory(directory);
+		metadataIndex->index(names);
+
+		if (filesInDirectory.size() == 0 || currentFileIndex < 0 || currentFileIndex >= filesInDirectory.size() || filesInDirectory.at(currentFileIndex) != filename) {
+			currentFileIndex = filesInDirectory.indexOf(filename);
+		}
+		currentThreadName = filename;
+		currentFileInfo = fileInfo;
+		prefetchPlanner.registerJump();
+		clearThreads();
+		launchImageThread(path, CurrentImagePriority);
+		updateImageThreads();
+		lock.unlock();
+		showCurrentImage();
+		if (waitingForCurrentImage) statusHint = tr("Loading...");
+		imageView->update();
+	}
+
+	///Shows \c image; \p sameContent indicates that it replaces a version of the same image at a different resolution.
+	void MainInterface::displayImageIfOk(bool sameContent) {
+		if (image.isValid()) {
+			currentImageUnreadable = false;
+			if (sameContent) {
+				//only the resolution changed, keep the view as it is
+				imageView->replaceImage(image.mat(), image.pixelScale(), image.isAlphaPremultiplied());
+			} else {
+				imageView->setImage(image.mat(), image.pixelScale(), image.isAlphaPremultiplied());
+			}
+			if (image.tileSource()) imageView->setTileSource(image.tileSource());
+			if (autoRotationAction->isChecked()) {
+				autoRotateImage();
+			}
+		} else {
+			currentImageUnreadable = true;
+			imageView->resetImage();
+		}
+		updateWindowTitle();
+		slideshowAction->setEnabled(true);
+		slideshowNoDialogAction->setEnabled(true);
+		refreshAction->setEnabled(true);
+	}
+
+	void MainInterface::updateWindowTitle() {
+		if (directoryModel->isListing()) {
+			setWindowTitle(QString("%1%3 - %2").arg(currentFileInfo.fileName(), programTitle, image.isPreviewImage() ? " [Preview]" : ""));
+			return;
+		}
+		setWindowTitle(QString("%1%5 - %2 - %3 of %4").arg(currentFileInfo.fileName(),
+															   programTitle).arg(currentFileIndex + 1).arg(filesInDirectory.size()).arg(image.isPreviewImage() ? " [Preview]" : ""));
+	}
+
+	void MainInterface::autoRotateImage() {
+		if (image.isValid()) {
+			FileMetadata metadata;
+			//the indexed orientation saves waiting for the EXIF data, unless there is none
+			if (image.exif()->isReady() || !metadataIndex->lookup(currentFileInfo, metadata)) {
+				image.exif()->join();
+				metadata = MetadataIndex::exifValues(*image.exif());
+			}
+			if (metadata.hasExif) {
+				long orientation = metadata.orientation;
+				imageView->setRotation(userRotation);
+				orientation = (orientation + 1) / 2;
+				if (orientation == 3) {
+					imageView->rotateBy(90);
+				} else if (orientation == 4) {
+					imageView->rotateBy(-90);
+				} else if (orientation == 2) {
+					imageView->rotateBy(180);
+				}
+			}
+		}
+	}
+
+	void MainInterface::enterFullscreen() {
+		//imageView->setInterfaceBackgroundColor(Qt::black);
+		showFullScreen();
+		hideMenuBar();
+		enableAutomaticMouseHide();
+		fullscreenAction->setChecked(true);
+	}
+
+	void MainInterface::exitFullscreen() {
+		//QPalette palette = qApp->palette();
+		//imageView->setInterfaceBackgroundColor(palette.base().color());
+		if (settings->value("maximized", false).toBool()) {
+			showMaximized();
+		} else {
+			showNormal();
+		}
+		if (menuBarAutoHideAction->isChecked()) showMenuBar();
+		disableAutomaticMouseHide();
+		fullscreenAction->setChecked(false);
+	}
+
+	void MainInterface::infoPaintFunction(QPainter& canvas) {
+		canvas.setRenderHint(QPainter::Antialiasing, true);
+		QPen textPen(Qt::black);
+		canvas.setPen(textPen);
+		canvas.setBrush(Qt::NoBrush);
+		QFont font;
+		font.setPointSize(fontSize);
+		canvas.setFont(font);
+		QColor base = Qt::white;
+		base.setAlpha(200);
+		canvas.setBackground(base);
+		canvas.setBackgroundMode(Qt::OpaqueMode);
+		QFontMetrics metrics(font);
+		if (currentImageUnreadable && statusHint.isEmpty()) {
+			QString message = tr("This file could not be read:");
+			canvas.drawText(QPoint((canvas.device()->width() - metrics.horizontalAdvance(message)) / 2.0, canvas.device()->height() / 2.0 - 0.5*lineSpacing),
+							message);
+			canvas.drawText(QPoint((canvas.device()->width() - metrics.horizontalAdvance(currentFileInfo.fileName())) / 2.0,
+								   canvas.device()->height() / 2.0 + 0.5*lineSpacing + metrics.height()),
+							currentFileInfo.fileName());
+		}
+		if (!statusHint.isEmpty()) {
+			canvas.drawText(QPoint((canvas.device()->width() - metrics.horizontalAdvance(statusHint)) / 2.0, canvas.device()->height() / 2.0 + 0.5*metrics.height()),
+							statusHint);
+		}
+		if (showInfoAction->isChecked() && imageView->getImageAssigned()) {
+			//draw current filename
+			canvas.drawText(QPoint(30, 30 + metrics.height()),
+							currentFileInfo.fileName());
+			int sizeAndResolutionTopOffset = 30 + lineSpacing + 2 * metrics.height();
+			if (image.isValid()) {
+				QString resolution = QString::fromWCharArray(L"%1\u2006x\u2006%2").arg(image.fullSize().width).arg(image.fullSize().height);
+				//which version of the image is on screen
+				QString stage;
+				if (showingEmbeddedPreview) {
+					stage = tr(" (embedded preview, decoding...)");
+				} else if (image.tileSource()) {
+					stage = tr(" (tiled, read as needed)");
+				} else if (image.isReducedToSizeLimit()) {
+					stage = tr(" [Reduced] (decoded at 1/%1 resolution, exceeds the size limit)").arg(std::lround(image.pixelScale()));
+				} else if (image.pixelScale() > 1 && !image.isPreviewImage()) {
+					stage = tr(" (decoded at 1/%1 resolution)").arg(std::lround(image.pixelScale()));
+				}
+				canvas.drawText(QPoint(30, sizeAndResolutionTopOffset),
+								QString::fromWCharArray(L"%1, %2\u2006Mb%3").arg(resolution).arg(currentFileInfo.size() / 1048576.0, 0, 'f', 2).arg(stage));
+				FileMetadata metadata;
+				bool metadataKnown = image.exif()->isReady();
+				if (metadataKnown) {
+					metadata = MetadataIndex::exifValues(*image.exif());
+				} else {
+					//until the EXIF data has been read the folder index may know the values already
+					metadataKnown = metadataIndex->lookup(currentFileInfo, metadata);
+				}
+				if (metadataKnown) {
+					if (metadata.hasExif) {
+						//get camera model, speed, aperture and ISO
+						QString cameraModel = metadata.cameraModel;
+						QString lensModel = metadata.lensModel;
+						QString aperture = metadata.fNumber;
+						QString speed = metadata.exposureTime;
+						QString focalLength = metadata.focalLength;
+						QString equivalentFocalLength = metadata.focalLength35mmEquivalent;
+						QString exposureBias = metadata.exposureBias;
+						QString iso = metadata.iso;
+						QString captureDate = metadata.captureDate;
+						//calculate the v coordinates for the lines
+						int heightOfOneLine = lineSpacing + metrics.height();
+						int topOffset = 30 + 2 * lineSpacing + 3 * metrics.height();
+
+						//draw the EXIF text (note \u2005 is a sixth of a quad)
+						if (!cameraModel.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											cameraModel);
+							topOffset += heightOfOneLine;
+						}
+						if (!lensModel.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											lensModel);
+							topOffset += heightOfOneLine;
+						}
+						if (!focalLength.isEmpty() && !equivalentFocalLength.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString::fromWCharArray(L"%1\u2006mm (\u2261 %2\u2006mm)").arg(focalLength).arg(equivalentFocalLength));
+							topOffset += heightOfOneLine;
+						} else if (!focalLength.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString::fromWCharArray(L"%1\u2006mm").arg(focalLength));
+							topOffset += heightOfOneLine;
+						} else if (!equivalentFocalLength.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString::fromWCharArray(L"%1\u2006mm (35\u2006mm equivalent)").arg(equivalentFocalLength));
+							topOffset += heightOfOneLine;
+						}
+						if (!speed.isEmpty() && !aperture.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString::fromWCharArray(L"%1\u2006s @ f/%2").arg(speed).arg(aperture));
+							topOffset += heightOfOneLine;
+						} else if (!speed.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString::fromWCharArray(L"%1\u2006s").arg(speed));
+							topOffset += heightOfOneLine;
+						} else if (!aperture.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString("f/%1").arg(aperture));
+							topOffset += heightOfOneLine;
+						}
+						if (!iso.isEmpty() && !exposureBias.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString::fromWCharArray(L"ISO\u2006%1, %2\u2006EV").arg(iso).arg(exposureBias));
+						  topOffset += heightOfOneLine;
+						} else if (!iso.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString::fromWCharArray(L"ISO\u2006%1").arg(iso));
+							topOffset += heightOfOneLine;
+						} else if (!exposureBias.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString::fromWCharArray(L"%1\u2006EV").arg(exposureBias));
+							topOffset += heightOfOneLine;
+						}
+						if (!captureDate.isEmpty()) {
+							canvas.drawText(QPoint(30, topOffset),
+											QString("%1").arg(captureDate));
+							topOffset += heightOfOneLine;
+						}
+						if (image.isPreviewImage()) {
+							canvas.drawText(QPoint(30, topOffset), "[Preview Image]");
+						}
+					}
+				} else {
+					canvas.drawText(QPoint(30, 30 + 2 * lineSpacing + 3 * metrics.height()),
+									tr("Loading EXIF..."));
+				}
+			}
+		}
+		if (zoomLevelAction->isChecked() && imageView->getImageAssigned()) {
+			QString message = QString::number(imageView->getCurrentPreviewScalingFactor() * 100, 'f', 1).append("%");
+			canvas.drawText(QPoint(30, canvas.device()->height() - 30), message);
+		}
+		if (showInfoAction->isChecked() && (skippedDecodeCount > 0 || abortedDecodeCount > 0)) {
+			//decodes that were not needed anymore because the user skipped past them
+			QString message = tr("Decodes saved: %1 skipped, %2 aborted").arg(skippedDecodeCount.load()).arg(abortedDecodeCount.load());
+			canvas.drawText(QPoint(canvas.device()->width() - 30 - metrics.horizontalAdvance(message), canvas.device()->height() - 30), message);
+		}
+	}
+
+	bool MainInterface::applicationIsInstalled() {
+#ifdef Q_OS_WIN
+		QSettings registry("HKEY_LOCAL_MACHINE\\SOFTWARE", QSettings::NativeFormat);
+		return registry.contains("Microsoft/Windows/CurrentVersion/Uninstall/AcuteViewer/UninstallString");
+#else
+		return false;
+#endif
+
+	}
+
+	void MainInterface::changeFontSizeBy(int value) {
+		if (showInfoAction->isChecked() || zoomLevelAction->isChecked()) {
+			if (fontSize + value >= 1) {
+				fontSize += value;
+				settings->setValue("fontSize", fontSize);
+				imageView->update();
+			}
+		}
+	}
+
+	void MainInterface::changeLineSpacingBy(int value) {
+		if (showInfoAction->isChecked()) {
+			if (int(lineSpacing) + value >= 0) {
+				lineSpacing += value;
+				settings->setValue("fontSize", lineSpacing);
+				imageView->update();
+			}
+		}
+	}
+
+	void MainInterface::loadSettings() {
+		fontSize = settings->value("fontSize", 14).toUInt();
+		if (fontSize < 1) fontSize = 1;
+		lineSpacing = settings->value("lineSpacing", 10).toUInt();
+		fileActionAction->setChecked(settings->value("enableHotkeys", true).toBool());
+		showInfoAction->setChecked(settings->value("showImageInfo", false).toBool());
+		zoomLevelAction->setChecked(settings->value("showZoomLevel", false).toBool());
+		enlargementAction->setChecked(settings->value("enlargeSmallImages", false).toBool());
+		toggleSmallImageUpscaling(enlargementAction->isChecked());
+		smoothingAction->setChecked(settings->value("useSmoothEnlargmentInterpolation", false).toBool());
+		toggleEnglargmentInterpolationMethod(smoothingAction->isChecked());
+		sharpeningAction->setChecked(settings->value("sharpenImagesAfterDownscale", false).toBool());
+		toggleSharpening(sharpeningAction->isChecked());
+		menuBarAutoHideAction->setChecked(!settings->value("autoHideMenuBar", true).toBool());
+		toggleMenuBarAutoHide(menuBarAutoHideAction->isChecked());
+		if (imageView->OpenClAvailable()) {
+			gpuAction->setChecked(settings->value("useGpu", true).toBool());
+		} else {
+			gpuAction->setChecked(false);
+			gpuAction->setEnabled(false);
+		}
+		toggleGpu(gpuAction->isChecked());
+		updatePerformanceSettings();
+		QColor backgroundColor = settings->value("backgroundColor", QColor(Qt::black)).value<QColor>();
+		imageView->setInterfaceBackgroundColor(backgroundColor);
+		if (backgroundColor == Qt::black) {
+			backgroundColorBlackAction->setChecked(true);
+		} else if (backgroundColor == Qt::white) {
+			backgroundColorWhiteAction->setChecked(true);
+		} else if (backgroundColor == darkGray) {
+			backgroundColorGrayAction->setChecked(true);
+		} else {
+			backgroundColorCustomAction->setChecked(true);
+		}
+		includePartiallySupportedFilesAction->setChecked(settings->value("includePreviewOnlyFiles", true).toBool());
+		autoRotationAction->setChecked(settings->value("autoRotateImages", true).toBool());
+	}
+
+	void MainInterface::deleteCurrentImage(bool askForConfirmation, bool includeSidecarFiles, bool onlyXmp) {
+		if (askForConfirmation) {
+			QMessageBox msgBox;
+			msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+			msgBox.setDefaultButton(QMessageBox::No);
+			msgBox.setWindowTitle(tr("Delete File"));
+			msgBox.setText(tr("Please confirm that you want to delete this file."));
+			msgBox.setButtonText(QMessageBox::Yes, tr("Delete"));
+			msgBox.setButtonText(QMessageBox::No, tr("Do not Delete"));
+			msgBox.setIcon(QMessageBox::Question);
+			if (msgBox.exec() == QMessageBox::No) return;
+		}
+
+		QString filepath = getFullImagePath(currentFileIndex);
+		if (QFileInfo(filepath).exists()) {
+			if (utility::moveFileToRecycleBin(filepath)) {
+				if (includeSidecarFiles && supportedRawFormats.contains(QFileInfo(filepath).suffix().toLower())) {
+					QString extension = onlyXmp ? "xmp" : "*";
+					QStringList filters;
+					filters << QString("%1.%2").arg(QFileInfo(filepath).baseName(), extension);
+					QStringList contents = currentDirectory.entryList(filters, QDir::Files);
+					for (QString const & file : contents) {
+						if (!utility::moveFileToRecycleBin(currentDirectory.absoluteFilePath(file))) {
+							QMessageBox::critical(this,
+												  tr("Sidecar File Not Deleted"),
+												  tr("The sidecar file %1 could not be deleted. Please check that you have the required permissions and that the path length does not exceed MAX_PATH.").arg(file),
+												  QMessageBox::StandardButton::Close,
+												  QMessageBox::StandardButton::Close);
+						}
+					}
+				}
+				removeCurrentImageFromList(includeSidecarFiles, onlyXmp);
+			} else {
+#ifdef Q_OS_WIN
+				QMessageBox::critical(this,
+									  tr("File Not Deleted"),
+									  tr("The file could not be deleted. Please check that you have the required permissions and that the path length does not exceed MAX_PATH."),
+									  QMessageBox::StandardButton::Close,
+									  QMessageBox::StandardButton::Close);
+#else
+				QMessageBox::critical(this,
+									  tr("File Not Deleted"),
+									  tr("The file could not be deleted. Please check that you have the required permissions. It might also be that your trash folder is not at the default location."),
+									  QMessageBox::StandardButton::Close,
+									  QMessageBox::StandardButton::Close);
+#endif
+			}
+
+		} else {
+			QMessageBox::critical(this,
+								  tr("File Not Found"),
+								  tr("The file could not be deleted because it no longer exists."),
+								  QMessageBox::StandardButton::Close,
+								  QMessageBox::StandardButton::Close);
+		}
+	}
+
+	void MainInterface::moveCurrentImage(QString const & newFolder, bool askForConfirmation, bool includeSidecarFiles, bool onlyXmp) {
+		if (askForConfirmation) {
+			QMessageBox msgBox;
+			msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+			msgBox.setDefaultButton(QMessageBox::No);
+			msgBox.setWindowTitle(tr("Move File"));
+			msgBox.setText(tr("Please confirm that you want to move this file to the folder you specified."));
+			msgBox.setButtonText(QMessageBox::Yes, tr("Move"));
+			msgBox.setButtonText(QMessageBox::No, tr("Do not Move"));
+			msgBox.setIcon(QMessageBox::Question);
+			if (msgBox.exec() == QMessageBox::No) return;
+		}
+		QDir dir = QDir(newFolder);
+		QString oldPath = getFullImagePath(currentFileIndex);
+		QString newPath = dir.absoluteFilePath(filesInDirectory[currentFileIndex]);
+		if (utility::moveFile(oldPath, newPath, false, this)) {
+			if (includeSidecarFiles && supportedRawFormats.contains(QFileInfo(oldPath).suffix().toLower())) {
+				QString extension = onlyXmp ? "xmp" : "*";
+				QStringList filters;
+				filters << QString("%1.%2").arg(QFileInfo(oldPath).baseName(), extension);
+				QStringList contents = currentDirectory.entryList(filters, QDir::Files);
+				for (QString const & file : contents) {
+					if (!utility::moveFile(currentDirectory.absoluteFilePath(file), dir.absoluteFilePath(file), true, this)) {
+						QMessageBox::critical(this,
+											  tr("Sidecar File Not Moved"),
+											  tr("The sidecar file %1 could not be deleted. Please check that you have the required permissions and that the path length does not exceed MAX_PATH.").arg(file),
+											  QMessageBox::StandardButton::Close,
+											  QMessageBox::StandardButton::Close);
+					}
+				}
+			}
+			removeCurrentImageFromList(includeSidecarFiles, onlyXmp);
+		}
+	}
+
+	void MainInterface::copyCurrentImage(QString const & newFolder, bool askForConfirmation, bool includeSidecarFiles, bool onlyXmp) {
+		if (askForConfirmation) {
+			QMessageBox msgBox;
+			msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+			msgBox.setDefaultButton(QMessageBox::No);
+			msgBox.setWindowTitle(tr("Copy File"));
+			msgBox.setText(tr("Please confirm that you want to copy this file to the folder you specified."));
+			msgBox.setButtonText(QMessageBox::Yes, tr("Copy"));
+			msgBox.setButtonText(QMessageBox::No, tr("Do not Copy"));
+			msgBox.setIcon(QMessageBox::Question);
+			if (msgBox.exec() == QMessageBox::No) return;
+		}
+		QDir dir = QDir(newFolder);
+		QString oldPath = getFullImagePath(currentFileIndex);
+		QString newPath = dir.absoluteFilePath(filesInDirectory[currentFileIndex]);
+		if (utility::copyFile(oldPath, newPath, false, this)) {
+			if (includeSidecarFiles && supportedRawFormats.contains(QFileInfo(oldPath).suffix().toLower())) {
+				QString extension = onlyXmp ? "xmp" : "*";
+				QStringList filters;
+				filters << QString("%1.%2").arg(QFileInfo(oldPath).baseName(), extension);
+				QStringList contents = currentDirectory.entryList(filters, QDir::Files);
+				for (QString const & file : contents) {
+					if (!utility::copyFile(currentDirectory.absoluteFilePath(file), dir.absoluteFilePath(file), true, this)) {
+						QMessageBox::critical(this,
+											  tr("Sidecar File Not Copied"),
+											  tr("The sidecar file %1 could not be copied. Please check that you have the required permissions and that the path length does not exceed MAX_PATH.").arg(file),
+											  QMessageBox::StandardButton::Close,
+											  QMessageBox::StandardButton::Close);
+					}
+				}
+			}
+		}
+
+	}
+
+	//============================================================================ PRIVATE SLOTS =============================================================================\\
+
+	void MainInterface::refresh() {
+		if (currentFileIndex >= 0 && filesInDirectory.size() > 0) {
+			loadImage(getFullImagePath(currentFileIndex));
+		}
+	}
+
+	void MainInterface::showHotkeyDialog() {
+		disableAutomaticMouseHide();
+		hotkeyDialog->show();
+	}
+
+	void MainInterface::nextSlide() {
+		loadNextImage();
+		if (!settings->value("slideshowLoop", false).toBool() && currentFileIndex == (filesInDirectory.size() - 1)) {
+			stopSlideshow();
+		}
+	}
+
+	void MainInterface::cleanUpThreads() {
+		try {
+			std::lock_guard<std::mutex> lock(threadDeletionMutex);
+			//the current image and the rest of the prefetch window are never evicted
+			QSet<QString> pinned;
+			for (QPair<QString, int> const& entry : prefetchWindow()) {
+				pinned.insert(entry.first);
+			}
+			//if images that should be evicted are still loading, try again later
+			bool done = imageCache.trim(pinned);
+			abandonedTasks.erase(std::remove_if(abandonedTasks.begin(), abandonedTasks.end(), [this](ThreadPool::TaskHandle const& task) {
+				return threadPool->isDone(task);
+			}), abandonedTasks.end());
+			if (!done || !abandonedTasks.isEmpty()) threadCleanUpTimer->start(threadCleanUpInterval);
+		} catch (...) {
+			//Probably couldn't lock the mutex (thread already owns it?)
+			threadCleanUpTimer->start(threadCleanUpInterval);
+		}
+	}
+
+	void MainInterface::quit() {
+		QCoreApplication::quit();
+	}
+
+	void MainInterface::saveWindowSize() {
+		settings->setValue("windowSize", size());
+		settings->setValue("windowPosition", pos());
+		QMessageBox::information(this,
+								 tr("Successfull"),
+								 tr("The current size and position of the window have been saved as the new default."),
+								 QMessageBox::Close);
+	}
+
+	void MainInterface::hideMouse() const {
+		qApp->setOverrideCursor(Qt::BlankCursor);
+		mouseHideTimer->stop();
+	}
+
+	void MainInterface::showMouse() const {
+		qApp->setOverrideCursor(Qt::ArrowCursor);
+	}
+
+	void MainInterface::enableAutomaticMouseHide() {
+		if (isFullScreen() && !menuBar()->isVisible() && !slideshowDialog->isVisible() && !sharpeningDialog->isVisible() && !performanceDialog->isVisible() && !hotkeyDialog->isVisible()) {
+			mouseHideTimer->start(mouseHideDelay);
+		}
+	}
+
+	void MainInterface::disableAutomaticMouseHide() {
+		mouseHideTimer->stop();
+		showMouse();
+	}
+
+	void MainInterface::showMenuBar() {
+		if (isFullScreen()) disableAutomaticMouseHide();
+		menuBar()->setVisible(true);
+	}
+
+	void MainInterface::hideMenuBar(QAction* triggeringAction) {
+		if (!menuBarAutoHideAction->isChecked() || isFullScreen()) {
+			menuBar()->setVisible(false);
+			enableAutomaticMouseHide();
+		}
+	}
+
+	void MainInterface::populateApplicationMenu() {
+		applicationMenu->removeAction(installAction);
+		applicationMenu->removeAction(uninstallAction);
+		if (applicationIsInstalled()) {
+			applicationMenu->insertAction(aboutAction, uninstallAction);
+		} else {
+			applicationMenu->insertAction(aboutAction, installAction);
+		}
+
+	}
+
+	void MainInterface::runInstaller() {
+#ifdef Q_OS_WIN
+		QString installerPath = QDir(QCoreApplication::applicationDirPath()).absoluteFilePath("WinInstaller.exe");
+		if (QFileInfo(installerPath).exists()) {
+			ShellExecuteW(GetDesktopWindow(),
+						  nullptr,
+						  reinterpret_cast<LPCWSTR>(installerPath.utf16()),
+						  nullptr,
+						  reinterpret_cast<LPCWSTR>(QCoreApplication::applicationDirPath().utf16()),
+						  SW_SHOWNORMAL);
+			QCoreApplication::quit();
+		} else {
+			QMessageBox::critical(this,
+								  tr("Installer not found"),
+								  tr("The installer executable (WinInstaller.exe) could not be found. Make sure it is located in the same directory as AcuteViewer.exe."),
+								  QMessageBox::Close);
+		}
+#endif
+	}
+
+	void MainInterface::runUninstaller() {
+#ifdef Q_OS_WIN
+		QString installerPath = QDir::toNativeSeparators(QDir(QCoreApplication::applicationDirPath()).absoluteFilePath("WinInstaller.exe"));
+		if (QFileInfo(installerPath).exists()) {
+			ShellExecuteW(GetDesktopWindow(),
+						  nullptr,
+						  reinterpret_cast<LPCWSTR>(installerPath.utf16()),
+						  L"-uninstall",
+						  reinterpret_cast<LPCWSTR>(QCoreApplication::applicationDirPath().utf16()),
+						  SW_SHOWNORMAL);
+			QCoreApplication::quit();
+		} else {
+			QMessageBox::critical(this,
+								  tr("Installer not found"),
+								  tr("The installer executable (WinInstaller.exe) could not be found. Make sure it is located in the same directory as AcuteViewer.exe."),
+								  QMessageBox::Close);
+		}
+#endif
+	}
+
+	void MainInterface::resetSettings() {
+		if (QMessageBox::Yes == QMessageBox::question(this,
+													  tr("Reset Application Settings"),
+													  tr("Are you sure you want to reset all application settings to the default values?"),
+													  QMessageBox::Yes | QMessageBox::No)) {
+			settings->clear();
+			loadSettings();
+			imageView->update();
+			QMessageBox::information(this,
+									 tr("Reset Successfull"),
+									 tr("The application settings have been reset to the default values."),
+									 QMessageBox::Close);
+		}
+	}
+
+	void MainInterface::toggleSlideshow() {
+		if (slideshowTimer->isActive()) {
+			stopSlideshow();
+		} else {
+			slideshowDialog->show();
+			disableAutomaticMouseHide();
+		}
+	}
+
+	void MainInterface::toggleSlideshowNoDialog() {
+		if (slideshowTimer->isActive()) {
+			stopSlideshow();
+		} else {
+			startSlideshow();
+		}
+	}
+
+	void MainInterface::startSlideshow() {
+		slideshowAction->setText(tr("&Stop Slideshow"));
+		slideshowTimer->start(std::abs(settings->value("slideDelay", 3).toDouble()) * 1000);
+	}
+
+	void MainInterface::stopSlideshow() {
+		slideshowAction->setText(tr("&Start Slideshow"));
+		slideshowTimer->stop();
+	}
+
+	void MainInterface::toggleFullscreen() {
+		if (isFullScreen()) {
+			exitFullscreen();
+		} else {
+			enterFullscreen();
+		}
+	}
+
+	void MainInterface::rotateLeft() {
+		userRotation -= 90;
+		imageView->rotateLeft();
+	}
+
+	void MainInterface::rotateRight() {
+		userRotation += 90;
+		imageView->rotateRight();
+	}
+
+	void MainInterface::resetRotation() {
+		userRotation = 0;
+		imageView->setRotation(0);
+		if (autoRotationAction->isChecked()) autoRotateImage();
+	}
+
+	void MainInterface::zoomTo100() {
+		skipNextAltRelease = true;
+		imageView->zoomToHundredPercent();
+	}
+
+	void MainInterface::toggleGpu(bool value) {
+		imageView->setUseGpu(value);
+		settings->setValue("useGpu", value);
+	}
+
+	void MainInterface::toggleInfoOverlay(bool value) {
+		//if the thread of the currently displayed image is ready, start loading exif
+		if (!currentThreadName.isEmpty()
+			&& currentThread().valid()
+			&& currentThread().wait_for(std::chrono::milliseconds(0)) == std::future_status::ready
+			&& currentThread().get().isValid()) {
+			currentThread().get().exif()->startLoading();
+		}
+		if (image.isValid()) image.exif()->startLoading();
+		imageView->update();
+		settings->setValue("showImageInfo", value);
+	}
+
+	void MainInterface::toggleZoomLevelOverlay(bool value) {
+		imageView->update();
+		settings->setValue("showZoomLevel", value);
+	}
+
+	void MainInterface::reactToReadImageCompletion(QString filename, Image image) {
+		if (waitingForFullResolution && !waitingForCurrentImage && filename == currentThreadName) {
+			//swap the reduced decode that is on screen for the full resolution without changing the view
+			waitingForFullResolution = false;
+			if (image.isValid()) {
+				this->image = image;
+				if (exifIsRequired()) image.exif()->startLoading();
+				displayImageIfOk(true);
+			}
+			return;
+		}
+		if (!waitingForCurrentImage || filename != currentThreadName) {
+			//a prefetched image, it stays in the cache until it is needed; the cache may have grown beyond its budget though
+			if (!threadCleanUpTimer->isActive()) threadCleanUpTimer->start(threadCleanUpInterval);
+			return;
+		}
+		waitingForCurrentImage = false;
+		//if the decode failed, the embedded preview that is on screen is the best there is
+		if (!showingEmbeddedPreview || image.isValid()) {
+			this->image = image;
+			//calling this function although the exif might not be set to deferred loading is no problem (it checks internally)
+			if (exifIsRequired() && image.isValid()) image.exif()->startLoading();
+			statusHint = QString();
+			displayImageIfOk(showingEmbeddedPreview);
+		}
+		showingEmbeddedPreview = false;
+		imageView->update();
+		if (filesInDirectory.size() != 0) {
+			//preload next and previous image in background
+			std::lock_guard<std::mutex> lock(threadDeletionMutex);
+			updateImageThreads();
+		}
+	}
+
+	///Takes over the listing of the folder that was started when the current image was opened.
+	void MainInterface::reactToDirectoryListing() {
+		std::unique_lock<std::mutex> lock(threadDeletionMutex);
+		if (!directoryModel->files().contains(currentThreadName)) {
+			//the opened file was deleted or moved while the folder was listed (then the view has been reset already) or is not
+			//one the filters admit; either way the current state is kept and there is nothing to navigate from
+			pendingNavigationSteps = 0;
+			lock.unlock();
+			directoryModel->clear();
+			return;
+		}
+		filesInDirectory.assign(directoryModel->files());
+		currentFileIndex = filesInDirectory.indexOf(currentThreadName);
+		metadataIndex->prune(directoryModel->files());
+		metadataIndex->index(directoryModel->files());
+		//the steps the user took while the folder was listed are taken at once, only the image they lead to is loaded
+		int steps = loading ? 0 : pendingNavigationSteps;
+		pendingNavigationSteps = 0;
+		if (steps != 0) {
+			currentFileIndex = fileIndexAt(steps);
+			currentThreadName = filesInDirectory[currentFileIndex];
+			prefetchPlanner.registerStep(steps > 0);
+			currentFileInfo = QFileInfo(getFullImagePath(currentFileIndex));
+		}
+		//now the neighbours can be prefetched
+		updateImageThreads();
+		lock.unlock();
+		if (steps != 0) {
+			showCurrentImage();
+			cleanUpThreads();
+		} else if (!waitingForCurrentImage && image.isValid()) {
+			updateWindowTitle();
+		}
+	}
+
+	///Inserts a file that appeared in the folder, e.g. from a tethered camera, at its sorted position \p index.
+	void MainInterface::reactToFileAddition(QString name, int index) {
+		std::unique_lock<std::mutex> lock(threadDeletionMutex);
+		//the list mirrors the directory model, every change to it goes through the model
+		if (index < 0 || index > filesInDirectory.size()) return;
+		filesInDirectory.insert(index, name);
+		if (currentFileIndex >= index) ++currentFileIndex;
+		metadataIndex->index({ name }, true);
+		//the new file may be within the prefetch window
+		updateImageThreads();
+		lock.unlock();
+		if (!waitingForCurrentImage && image.isValid()) updateWindowTitle();
+	}
+
+	///Removes a file that was deleted or moved out of the folder by another application.
+	void MainInterface::reactToFileRemoval(QString name, int index) {
+		if (index < 0 || index >= filesInDirectory.size() || filesInDirectory[index] != name) return;
+		if (index == currentFileIndex) {
+			//the same as deleting it from within the application, the next image is shown
+			removeCurrentImageFromList();
+			return;
+		}
+		std::unique_lock<std::mutex> lock(threadDeletionMutex);
+		filesInDirectory.remove(index);
+		if (currentFileIndex > index) --currentFileIndex;
+		updateImageThreads();
+		lock.unlock();
+		if (!waitingForCurrentImage && image.isValid()) updateWindowTitle();
+		cleanUpThreads();
+	}
+
+	void MainInterface::reactToEmbeddedPreviewCompletion(QString filename, Image preview) {
+		//only of use as long as the decode of the current image has not arrived yet
+		if (!waitingForCurrentImage || filename != currentThreadName) return;
+		showingEmbeddedPreview = true;
+		image = preview;
+		statusHint = QString();
+		displayImageIfOk();
+	}
+
+	void MainInterface::reactToExifLoadingCompletion(ExifData* sender) {
+		if (showInfoAction->isChecked()) {
+		//if the sender is the currently displayed image
+			if (image.exif().get() == sender) {
+				update();
+			}
+		}
+	}
+
+	void MainInterface::openDialog() {
+		QString supportedFiles = QString("Fully Supported Images (") + supportedExtensions.join(" ") + QString(")");
+		QStringList allTypes;
+		allTypes << supportedExtensions << partiallySupportedExtensions;
+		allTypes.sort();
+		QString partiallySupportedFiles = QString("All Supported Images (") + allTypes.join(" ") + QString(")");
+		QString filters = QString("All Files (*.*);; %1;; %2;;").arg(partiallySupportedFiles).arg(supportedFiles);
+		QStringList paths = QFileDialog::getOpenFileNames(this,
+														  tr("Open Config File"),
+														  settings->value("lastOpenPath", QDir::rootPath()).toString(),
+														  filters);
+
+		if (!(paths.size() < 1)) {
+			settings->setValue("lastOpenPath", QFileInfo(paths.at(0)).path());
+			if (paths.size() == 1) {
+				loadImage(paths.at(0));
+			} else {
+				loadImages(paths);
+			}
+		}
+	}
+
+	void MainInterface::toggleEnglargmentInterpolationMethod(bool value) {
+		imageView->setUseSmoothTransform(value);
+		settings->setValue("useSmoothEnlargmentInterpolation", value);
+	}
+
+	void MainInterface::toggleSmallImageUpscaling(bool value) {
+		imageView->setPreventMagnificationInDefaultZoom(!value);
+		settings->setValue("enlargeSmallImages", value);
+	}
+
+	void MainInterface::toggleSharpening(bool value) {
+		imageView->setEnablePostResizeSharpening(value);
+		settings->setValue("sharpenImagesAfterDownscale", value);
+	}
+
+	void MainInterface::toggleMenuBarAutoHide(bool value) {
+		settings->setValue("autoHideMenuBar", !value);
+		if (value) {
+			showMenuBar();
+		} else {
+			hideMenuBar();
+		}
+	}
+
+	void MainInterface::togglePreviewOnlyFiles(bool value) {
+		settings->setValue("includePreviewOnlyFiles", value);
+		refresh();
+	}
+
+	void MainInterface::showSharpeningOptions() {
+		disableAutomaticMouseHide();
+		sharpeningDialog->show();
+		sharpeningDialog->raise();
+		sharpeningDialog->activateWindow();
+	}
+
+	void MainInterface::showPerformanceOptions() {
+		disableAutomaticMouseHide();
+		performanceDialog->show();
+		performanceDialog->raise();
+		performanceDialog->activateWindow();
+	}
+
+	void MainInterface::updatePerformanceSettings() {
+		size_t budget = size_t(std::max(0, settings->value("imageCacheSize", 2048).toInt())) * 1048576;
+		imageCache.setBudget(budget);
+		prefetchPlanner.setMemoryBudget(budget);
+		prefetchPlanner.setMaxAhead(settings->value("prefetchAhead", 6).toInt());
+		prefetchPlanner.setMaxBehind(settings->value("prefetchBehind", 2).toInt());
+		useReducedDecoding = settings->value("reducedJpegDecoding", true).toBool();
+		highBitDepthGamma = settings->value("highBitDepthGamma", 1.0).toDouble();
+		convertForPainting = settings->value("convertForPainting", false).toBool();
+		maximumImagePixels = qint64(std::max(1, settings->value("maximumImageResolution", 250).toInt())) * 1000000;
+		updateDecodeResolution();
+		cleanUpThreads();
+	}
+
+	///Decodes the current image at full resolution if it was decoded at a reduced one that is no longer sufficient for the current magnification.
+	void MainInterface::updateDecodeResolution() {
+		//an image reduced to the size limit is already at the highest resolution allowed; one reduced further to fit the window can be re-decoded at up to that resolution
+		if (!image.isValid() || image.reductionFactor() <= 1 || image.isReducedToSizeLimit() || waitingForCurrentImage || waitingForFullResolution) return;
+		//the reduced decode is sufficient as long as its pixels are not enlarged on screen
+		if (useReducedDecoding && imageView->getCurrentPreviewScalingFactor() * imageView->devicePixelRatioF() * image.pixelScale() <= 1) return;
+		std::lock_guard<std::mutex> lock(threadDeletionMutex);
+		waitingForFullResolution = true;
+		abandonImageThread(currentThreadName);
+		launchImageThread(currentFileInfo.absoluteFilePath(), CurrentImagePriority, true);
+	}
+
+	void MainInterface::updateSharpening() {
+		sharpeningAction->setChecked(settings->value("sharpenImagesAfterDownscale", false).toBool());
+		imageView->setPostResizeSharpening(sharpeningAction->isChecked(),
+												 settings->value("sharpeningStrength", 0.5).toDouble(),
+												 settings->value("sharpeningRadius", 1).toDouble());
+	}
+
+	void MainInterface::changeBackgroundColor(QAction* action) {
+		if (action == backgroundColorBlackAction) {
+			imageView->setInterfaceBackgroundColor(Qt::black);
+			settings->setValue("backgroundColor", QColor(Qt::black));
+		} else if (action == backgroundColorGrayAction) {
+			imageView->setInterfaceBackgroundColor(darkGray);
+			settings->setValue("backgroundColor", darkGray);
+		} else if (action == backgroundColorWhiteAction) {
+			imageView->setInterfaceBackgroundColor(Qt::white);
+			settings->setValue("backgroundColor", QColor(Qt::white));
+		} else if (action == backgroundColorCustomAction) {
+			QColor color = QColorDialog::getColor(settings->value("lastCustomColor", QColor(Qt::black)).value<QColor>(), this, tr("Choose Background Colour"));
+			if (color.isValid()) {
+				settings->setValue("lastCustomColor", color);
+				settings->setValue("backgroundColor", color);
+				imageView->setInterfaceBackgroundColor(color);
+			} else {
+				if (imageView->getInterfaceBackgroundColor() == Qt::black) {
+					backgroundColorBlackAction->setChecked(true);
+				} else if (imageView->getInterfaceBackgroundColor() == darkGray) {
+					backgroundColorGrayAction->setChecked(true);
+				} else if (imageView->getInterfaceBackgroundColor() == Qt::white) {
+					backgroundColorWhiteAction->setChecked(true);
+				}
+			}
+		}
+	}
+
+	void MainInterface::toggleAutoRotation(bool value) {
+		settings->setValue("autoRotateImages", value);
+		if (value) {
+			autoRotateImage();
+		} else {
+			imageView->setRotation(userRotation);
+		}
+	}
+
+	void MainInterface::triggerCustomAction1() {
+		if (filesInDirectory.size() > 0 && !loading) {
+			loading = true;
+			if (hotkeyDialog->getAction1() == 0) {
+				statusHint = tr("Deleting...");
+				update();
+				deleteCurrentImage(hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles());
+			} else if (hotkeyDialog->getAction1() == 1) {
+				statusHint = tr("Moving...");
+				update();
+				moveCurrentImage(hotkeyDialog->getFolder1(), hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles());
+			} else if (hotkeyDialog->getAction1() == 2) {
+				statusHint = tr("Copying...");
+				update();
+				copyCurrentImage(hotkeyDialog->getFolder1(), hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles());
+			}
+			statusHint = QString();
+			loading = false;
+			update();
+		}
+	}
+
+	void MainInterface::triggerCustomAction2() { 
+		if (filesInDirectory.size() > 0 && !loading) {
+			loading = true;
+			if (hotkeyDialog->getAction2() == 0) {
+				statusHint = tr("Deleting...");
+				update();
+				deleteCurrentImage(hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles(), hotkeyDialog->getSidecarType());
+			} else if (hotkeyDialog->getAction2() == 1) {
+				statusHint = tr("Moving...");
+				update();
+				moveCurrentImage(hotkeyDialog->getFolder2(), hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles(), hotkeyDialog->getSidecarType());
+			} else if (hotkeyDialog->getAction2() == 2) {
+				statusHint = tr("Copying...");
+				update();
+				copyCurrentImage(hotkeyDialog->getFolder2(), hotkeyDialog->getShowConfirmation(), hotkeyDialog->getIncludeSidecarFiles(), hotkeyDialog->getSidecarType());
+			}
+			statusHint = QString();
+			loading = false;
+			update();
+		}
+	}
+
+	void MainInterface::updateCustomHotkeys() {
+		fileActionAction->setChecked(hotkeyDialog->getHotkeysEnabled());
+		customAction1->setEnabled(hotkeyDialog->getHotkeysEnabled() && hotkeyDialog->getHotkey1Enabled());
+		customAction2->setEnabled(hotkeyDialog->getHotkeysEnabled() && hotkeyDialog->getHotkey2Enabled());
+		customAction1->setShortcut(hotkeyDialog->getKeySequence1());
+		customAction2->setShortcut(hotkeyDialog->getKeySequence2());
+	}
+
 }
\ No newline at end of file
@@ -1,230 +1,269 @@
-#pragma once
-
-#include <iostream>
-#include <future>
-#include <chrono>
-#include <memory>
-
-//OpenCV
-#include <opencv2/core.hpp>
-#include <opencv2/imgcodecs.hpp>
-#include <opencv2/highgui.hpp>
-
-#include "utility.h"
-#include "ExifData.h"
-#include "ImageView.h"
-#include "SlideshowDialog.h"
-#include "SharpeningDialog.h"
-#include "HotkeyDialog.h"
-#include "AboutDialog.h"
-
-namespace sv {
-
-	class Image {
-	public:
-		Image();
-		Image(cv::Mat mat, std::shared_ptr<ExifData> exifData, bool isPreviewImage = false);
-		cv::Mat mat() const;
-		std::shared_ptr<ExifData> exif() const;
-		bool isValid() const;
-		bool isPreviewImage() const;
-	private:
-		bool valid = false;
-		bool previewImage = false;
-		cv::Mat matrix;
-		std::shared_ptr<ExifData> exifData;
-	};
-
-	class MainInterface : public QMainWindow {
-		Q_OBJECT
-	public:
-		MainInterface(QString openWithFilename, QWidget *parent = 0);
-		MainInterface(QStringList openWithFilenames, QWidget *parent = 0);
-		~MainInterface();
-		QSize sizeHint() const;
-	protected:
-		bool eventFilter(QObject* object, QEvent* e);
-		void dragEnterEvent(QDragEnterEvent* e);
-		void dropEvent(QDropEvent* e);
-		void keyPressEvent(QKeyEvent* e);
-		void keyReleaseEvent(QKeyEvent* e);
-		void mouseDoubleClickEvent(QMouseEvent* e);
-		void mouseReleaseEvent(QMouseEvent* e);
-		void mouseMoveEvent(QMouseEvent* e);
-		void changeEvent(QEvent* e);
-		void wheelEvent(QWheelEvent* e);
-	private:
-		//functions
-		void initialize();
-		std::shared_future<Image>& currentThread();
-		bool exifIsRequired() const;
-		Image readImage(QString path, bool emitSignals = false);
-		void loadNextImage();
-		void loadPreviousImage();
-		void clearThreads();
-		template <typename T> void waitForThreadToFinish(std::shared_future<T> const& thread, bool indicateLoading = true);
-		size_t nextFileIndex() const;
-		size_t previousFileIndex() const;
-		void removeCurrentImageFromList(bool includeSidecarFiles = false, bool onlyXmp = true);
-		void reset();
-		QString getFullImagePath(size_t index) const;
-		void loadImage(QString path);
-		void loadImages(QStringList paths);
-		void displayImageIfOk();
-		void autoRotateImage();
-		void enterFullscreen();
-		void exitFullscreen();
-		void infoPaintFunction(QPainter& canvas);
-		bool applicationIsInstalled();
-		void changeFontSizeBy(int value);
-		void changeLineSpacingBy(int value);
-		void loadSettings();
-		void deleteCurrentImage(bool askForConfirmation = false, bool includeSidecarFiles = false, bool onlyXmp = true);
-		void moveCurrentImage(QString const & newFolder, bool askForConfirmation = false, bool includeSidecarFiles = false, bool onlyXmp = true);
-		void copyCurrentImage(QString const & newFolder, bool askForConfirmation = false, bool includeSidecarFiles = false, bool onlyXmp = true);
-
-		//variables
-		const QString programTitle = "Acute Viewer";
-		const QStringList supportedExtensions = { "*.bmp", "*.dib", "*.jpeg", "*.jpg", "*.jpe", "*.jpeg", "*.jp2", "*.png", "*.webp", "*.pbm", "*.pgm", "*.ppm", "*.sr", "*.ras", "*.tiff", "*.tif" };
-		const QStringList partiallySupportedExtensions = { "*.arw", "*.dng", "*.psd", "*.nef", "*.cr2", "*.crw", "*.mrw", "*.pef", "*.rw2", "*.sr2", "*.srf", "*.srw", "*.orf", "*.pgf", "*.raf"};
-		const QStringList supportedRawFormats = { "arw", "dng", "nef", "cr2", "crw", "mrw", "pef", "rw2", "sr2", "srf", "srw", "orf", "pgf", "raf" };
-		const int mouseHideDelay = 1000;
-		const int threadCleanUpInterval = 500;
-		const int eventProcessIntervalDuringWait = 16;
-		Image image;
-		std::atomic<bool> loading{ false };
-		std::mutex threadDeletionMutex;
-		QDir currentDirectory;
-		bool noCurrentDir = true;
-		QVector<QString> filesInDirectory;
-		long currentFileIndex = -1;
-		QString currentThreadName;
-		QFileInfo currentFileInfo;
-		std::atomic<bool> currentImageUnreadable{ false };
-		QString statusHint;
-
-		std::map<QString, std::shared_future<Image>> threads;
-		std::shared_ptr<QSettings> settings;
-		bool skipNextAltRelease = false;
-		unsigned int fontSize;
-		unsigned int lineSpacing;
-		QColor const darkGray = QColor(30, 30, 30);
-		double userRotation = 0;
-
-		//widgets
-		hb::ImageView* imageView;
-		SlideshowDialog* slideshowDialog;
-		SharpeningDialog* sharpeningDialog;
-		HotkeyDialog* hotkeyDialog;
-		AboutDialog* aboutDialog;
-		//menus
-		QMenu* fileMenu;
-		QMenu* viewMenu;
-		QMenu* zoomMenu;
-		QMenu* rotationMenu;
-		QMenu* sharpeningMenu;
-		QMenu* backgroundColorMenu;
-		QMenu* slideshowMenu;
-		QMenu* applicationMenu;
-		//actions
-		QAction* quitAction;
-		QAction* openAction;
-		QAction* refreshAction;
-		QAction* fileActionAction;
-		QAction* hotkeyOptionsAction;
-		QAction* resetSettingsAction;
-		QAction* showInfoAction;
-		QAction* smoothingAction;
-		QAction* enlargementAction;
-		QAction* sharpeningAction;
-		QAction* sharpeningOptionsAction;
-		QAction* menuBarAutoHideAction;
-		QAction* saveSizeAction;
-		QAction* gpuAction;
-		QAction* fullscreenAction;
-		QAction* rotateLeftAction;
-		QAction* rotateRightAction;
-		QAction* resetRotationAction;
-		QAction* autoRotationAction;
-		QAction* zoomTo100Action;
-		QAction* zoomToFitAction;
-		QAction* slideshowAction;
-		QAction* slideshowNoDialogAction;
-		QAction* zoomLevelAction;
-		QAction* backgroundColorCustomAction;
-		QAction* backgroundColorWhiteAction;
-		QAction* backgroundColorBlackAction;
-		QAction* backgroundColorGrayAction;
-		QAction* includePartiallySupportedFilesAction;
-		QAction* installAction;
-		QAction* uninstallAction;
-		QAction* aboutAction;
-		QAction* customAction1;
-		QAction* customAction2;
-		QActionGroup* backgroundColorActionGroup;
-		//timer
-		QTimer* mouseHideTimer;
-		QTimer* threadCleanUpTimer;
-		QTimer* slideshowTimer;
-	private slots:
-		void nextSlide();
-		void refresh();
-		void showHotkeyDialog();
-		void cleanUpThreads();
-		void quit();
-		void saveWindowSize();
-		void hideMouse() const;
-		void showMouse() const;
-		void enableAutomaticMouseHide();
-		void disableAutomaticMouseHide();
-		void showMenuBar();
-		void hideMenuBar(QAction* triggeringAction = nullptr);
-		void populateApplicationMenu();
-		void runInstaller();
-		void runUninstaller();
-		void resetSettings();
-		void toggleSlideshow();
-		void toggleSlideshowNoDialog();
-		void startSlideshow();
-		void stopSlideshow();
-		void toggleFullscreen();
-		void rotateLeft();
-		void rotateRight();
-		void resetRotation();
-		void zoomTo100();
-		void toggleGpu(bool value);
-		void toggleInfoOverlay(bool value);
-		void toggleZoomLevelOverlay(bool value);
-		void reactToReadImageCompletion(Image image);
-		void reactToExifLoadingCompletion(ExifData* sender);
-		void openDialog();
-		void toggleEnglargmentInterpolationMethod(bool value);
-		void toggleSmallImageUpscaling(bool value);
-		void toggleSharpening(bool value);
-		void toggleMenuBarAutoHide(bool value);
-		void togglePreviewOnlyFiles(bool value);
-		void showSharpeningOptions();
-		void updateSharpening();
-		void changeBackgroundColor(QAction* action);
-		void toggleAutoRotation(bool value);
-		void triggerCustomAction1();
-		void triggerCustomAction2();
-		void updateCustomHotkeys();
-	signals:
-		void readImageFinished(Image image);
-	};
-
-	//================================= Implementation of Template Functions =================================\\
-
-	template <typename T> void MainInterface::waitForThreadToFinish(std::shared_future<T> const& thread, bool indicateLoading) {
-		if (!thread.valid()) return;
-		if (thread.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready) {
-			if(indicateLoading) this->setWindowTitle(this->windowTitle() + QString(tr(" - Loading...")));
-		}
-
-		while (thread.wait_for(std::chrono::milliseconds(this->eventProcessIntervalDuringWait)) != std::future_status::ready) {
-			qApp->processEvents();
-		}
-	}
-
+#pragma once
+
+#include <iostream>
+#include <future>
+#include <chrono>
+#include <memory>
+#include <limits>
+
+//OpenCV
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/highgui.hpp>
+
+#include "utility.h"
+#include "ExifData.h"
+#include "ImageCache.h"
+#include "PrefetchPlanner.h"
+#include "ImageConversion.h"
+#include "AreaDownscaling.h"
+#include "ViewWorkerPool.h"
+#include "TiffTileSource.h"
+#include "DirectoryModel.h"
+#include "FileList.h"
+#include "MetadataIndex.h"
+#include "ImageView.h"
+#include "SlideshowDialog.h"
+#include "SharpeningDialog.h"
+#include "PerformanceDialog.h"
+#include "HotkeyDialog.h"
+#include "AboutDialog.h"
+
+namespace sv {
+
+	class MainInterface : public QMainWindow {
+		Q_OBJECT
+	public:
+		MainInterface(QString openWithFilename, QWidget *parent = 0);
+		MainInterface(QStringList openWithFilenames, QWidget *parent = 0);
+		~MainInterface();
+		QSize sizeHint() const;
+	protected:
+		bool eventFilter(QObject* object, QEvent* e);
+		void dragEnterEvent(QDragEnterEvent* e);
+		void dropEvent(QDropEvent* e);
+		void keyPressEvent(QKeyEvent* e);
+		void keyReleaseEvent(QKeyEvent* e);
+		void mouseDoubleClickEvent(QMouseEvent* e);
+		void mouseReleaseEvent(QMouseEvent* e);
+		void mouseMoveEvent(QMouseEvent* e);
+		void changeEvent(QEvent* e);
+		void wheelEvent(QWheelEvent* e);
+	private:
+		//priorities of the tasks in the thread pool, lower values are executed first
+		enum LoadingPriority : int { EmbeddedPreviewPriority = -1, CurrentImagePriority = 0, DirectoryListingPriority = 1, ExifPriority = 2, PrefetchPriority = 3, IndexingPriority = 1000 };
+
+		//functions
+		void initialize();
+		std::shared_future<Image> currentThread();
+		bool exifIsRequired() const;
+		Image readImage(QString path, ThreadPool::CancellationToken cancellation, QSize targetSize);
+		void loadNextImage();
+		void loadPreviousImage();
+		void showCurrentImage();
+		void launchEmbeddedPreview(QString const& path);
+		void readEmbeddedPreview(QString path, ThreadPool::CancellationToken cancellation);
+		void launchImageThread(QString const& path, int priority, bool fullResolution = false);
+		void updateImageThreads();
+		QSize decodeTargetSize() const;
+		Image readTiledImage(QString const& path, ThreadPool::CancellationToken cancellation);
+		QSize encodedImageSize(utility::FileBuffer const* fileData, QString const& path) const;
+		int reducedDecodeFactor(QString const& path, QSize targetSize, QSize imageSize) const;
+		cv::Mat readDownscaled(utility::FileBuffer const* fileData, QString const& path, QSize imageSize, ThreadPool::CancellationToken cancellation, bool& premultiplied) const;
+		void abandonImageThread(QString const& key);
+		QVector<QPair<QString, int>> prefetchWindow() const;
+		void clearThreads();
+		size_t nextFileIndex() const;
+		size_t previousFileIndex() const;
+		size_t fileIndexAt(long offset) const;
+		void removeCurrentImageFromList(bool includeSidecarFiles = false, bool onlyXmp = true);
+		void reset();
+		QString getFullImagePath(size_t index) const;
+		void loadImage(QString path);
+		void loadImages(QStringList paths);
+		void displayImageIfOk(bool sameContent = false);
+		void updateWindowTitle();
+		void autoRotateImage();
+		void enterFullscreen();
+		void exitFullscreen();
+		void infoPaintFunction(QPainter& canvas);
+		bool applicationIsInstalled();
+		void changeFontSizeBy(int value);
+		void changeLineSpacingBy(int value);
+		void loadSettings();
+		void deleteCurrentImage(bool askForConfirmation = false, bool includeSidecarFiles = false, bool onlyXmp = true);
+		void moveCurrentImage(QString const & newFolder, bool askForConfirmation = false, bool includeSidecarFiles = false, bool onlyXmp = true);
+		void copyCurrentImage(QString const & newFolder, bool askForConfirmation = false, bool includeSidecarFiles = false, bool onlyXmp = true);
+
+		//variables
+		const QString programTitle = "Acute Viewer";
+		const QStringList supportedExtensions = { "*.bmp", "*.dib", "*.jpeg", "*.jpg", "*.jpe", "*.jpeg", "*.jp2", "*.png", "*.webp", "*.pbm", "*.pgm", "*.ppm", "*.sr", "*.ras", "*.tiff", "*.tif" };
+		const QStringList partiallySupportedExtensions = { "*.arw", "*.dng", "*.psd", "*.nef", "*.cr2", "*.crw", "*.mrw", "*.pef", "*.rw2", "*.sr2", "*.srf", "*.srw", "*.orf", "*.pgf", "*.raf"};
+		const QStringList reducibleExtensions = { "jpg", "jpeg", "jpe" };
+		const QStringList embeddedPreviewExtensions = { "jpg", "jpeg", "jpe", "tif", "tiff" };
+		const QStringList tiledExtensions = { "tif", "tiff" };
+		//tiled images with more pixels are read tile by tile as needed instead of being decoded as a whole
+		const qint64 tiledDecodingThreshold = 100000000;
+		const int tiledOverviewSize = 4096;
+		const QStringList supportedRawFormats = { "arw", "dng", "nef", "cr2", "crw", "mrw", "pef", "rw2", "sr2", "srf", "srw", "orf", "pgf", "raf" };
+		const int mouseHideDelay = 1000;
+		const int threadCleanUpInterval = 500;
+		Image image;
+		std::atomic<bool> loading{ false };
+		bool waitingForCurrentImage = false;
+		bool waitingForFullResolution = false;
+		bool showingEmbeddedPreview = false;
+		ThreadPool::TaskHandle embeddedPreviewTask;
+		ThreadPool::CancellationToken embeddedPreviewCancellation;
+		bool useReducedDecoding = true;
+		//gamma applied when narrowing 16 bit and floating point images, read by the decoding threads
+		std::atomic<double> highBitDepthGamma{ 1.0 };
+		//decode into the four channel format Qt paints fastest, at the cost of more memory
+		std::atomic<bool> convertForPainting{ false };
+		//images with more pixels are decoded at a reduced resolution, so a single file cannot exhaust the memory
+		std::atomic<qint64> maximumImagePixels{ 250000000 };
+		std::mutex threadDeletionMutex;
+		QDir currentDirectory;
+		bool noCurrentDir = true;
+		//mirrors the directory model, or holds the files that were opened together
+		FileList filesInDirectory;
+		DirectoryModel* directoryModel;
+		//what the info overlay and the auto rotation can use before the EXIF data of an image has been read
+		MetadataIndex* metadataIndex;
+		//navigation steps requested while the folder was still listed, positive ones forward
+		int pendingNavigationSteps = 0;
+		long currentFileIndex = -1;
+		QString currentThreadName;
+		QFileInfo currentFileInfo;
+		std::atomic<bool> currentImageUnreadable{ false };
+		QString statusHint;
+
+		std::shared_ptr<ThreadPool> threadPool;
+		ImageCache imageCache;
+		//decodes that were asked to stop but may still be running, they must finish before this object is destroyed
+		QVector<ThreadPool::TaskHandle> abandonedTasks;
+		//how many decodes were dropped before they started or stopped before they finished
+		std::atomic<unsigned int> skippedDecodeCount{ 0 };
+		std::atomic<unsigned int> abortedDecodeCount{ 0 };
+		PrefetchPlanner prefetchPlanner;
+		std::shared_ptr<QSettings> settings;
+		bool skipNextAltRelease = false;
+		unsigned int fontSize;
+		unsigned int lineSpacing;
+		QColor const darkGray = QColor(30, 30, 30);
+		double userRotation = 0;
+
+		//widgets
+		hb::ImageView* imageView;
+		SlideshowDialog* slideshowDialog;
+		SharpeningDialog* sharpeningDialog;
+		PerformanceDialog* performanceDialog;
+		HotkeyDialog* hotkeyDialog;
+		AboutDialog* aboutDialog;
+		//menus
+		QMenu* fileMenu;
+		QMenu* viewMenu;
+		QMenu* zoomMenu;
+		QMenu* rotationMenu;
+		QMenu* sharpeningMenu;
+		QMenu* backgroundColorMenu;
+		QMenu* slideshowMenu;
+		QMenu* applicationMenu;
+		//actions
+		QAction* quitAction;
+		QAction* openAction;
+		QAction* refreshAction;
+		QAction* fileActionAction;
+		QAction* hotkeyOptionsAction;
+		QAction* resetSettingsAction;
+		QAction* showInfoAction;
+		QAction* smoothingAction;
+		QAction* enlargementAction;
+		QAction* sharpeningAction;
+		QAction* sharpeningOptionsAction;
+		QAction* menuBarAutoHideAction;
+		QAction* saveSizeAction;
+		QAction* gpuAction;
+		QAction* performanceOptionsAction;
+		QAction* fullscreenAction;
+		QAction* rotateLeftAction;
+		QAction* rotateRightAction;
+		QAction* resetRotationAction;
+		QAction* autoRotationAction;
+		QAction* zoomTo100Action;
+		QAction* zoomToFitAction;
+		QAction* slideshowAction;
+		QAction* slideshowNoDialogAction;
+		QAction* zoomLevelAction;
+		QAction* backgroundColorCustomAction;
+		QAction* backgroundColorWhiteAction;
+		QAction* backgroundColorBlackAction;
+		QAction* backgroundColorGrayAction;
+		QAction* includePartiallySupportedFilesAction;
+		QAction* installAction;
+		QAction* uninstallAction;
+		QAction* aboutAction;
+		QAction* customAction1;
+		QAction* customAction2;
+		QActionGroup* backgroundColorActionGroup;
+		//timer
+		QTimer* mouseHideTimer;
+		QTimer* threadCleanUpTimer;
+		QTimer* slideshowTimer;
+	private slots:
+		void nextSlide();
+		void refresh();
+		void showHotkeyDialog();
+		void cleanUpThreads();
+		void quit();
+		void saveWindowSize();
+		void hideMouse() const;
+		void showMouse() const;
+		void enableAutomaticMouseHide();
+		void disableAutomaticMouseHide();
+		void showMenuBar();
+		void hideMenuBar(QAction* triggeringAction = nullptr);
+		void populateApplicationMenu();
+		void runInstaller();
+		void runUninstaller();
+		void resetSettings();
+		void toggleSlideshow();
+		void toggleSlideshowNoDialog();
+		void startSlideshow();
+		void stopSlideshow();
+		void toggleFullscreen();
+		void rotateLeft();
+		void rotateRight();
+		void resetRotation();
+		void zoomTo100();
+		void toggleGpu(bool value);
+		void showPerformanceOptions();
+		void updatePerformanceSettings();
+		void updateDecodeResolution();
+		void toggleInfoOverlay(bool value);
+		void toggleZoomLevelOverlay(bool value);
+		void reactToReadImageCompletion(QString filename, Image image);
+		void reactToEmbeddedPreviewCompletion(QString filename, Image preview);
+		void reactToDirectoryListing();
+		void reactToFileAddition(QString name, int index);
+		void reactToFileRemoval(QString name, int index);
+		void reactToExifLoadingCompletion(ExifData* sender);
+		void openDialog();
+		void toggleEnglargmentInterpolationMethod(bool value);
+		void toggleSmallImageUpscaling(bool value);
+		void toggleSharpening(bool value);
+		void toggleMenuBarAutoHide(bool value);
+		void togglePreviewOnlyFiles(bool value);
+		void showSharpeningOptions();
+		void updateSharpening();
+		void changeBackgroundColor(QAction* action);
+		void toggleAutoRotation(bool value);
+		void triggerCustomAction1();
+		void triggerCustomAction2();
+		void updateCustomHotkeys();
+	signals:
+		void readImageFinished(QString filename, Image image);
+		void embeddedPreviewFinished(QString filename, Image preview);
+	};
+
 }
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "MetadataIndex.h"
+
+namespace sv {
+
+	QDataStream& operator<<(QDataStream& stream, FileMetadata const& metadata) {
+		stream << metadata.modified << metadata.size << metadata.dimensions << qint32(metadata.orientation) << metadata.hasExif
+			<< metadata.captureDate << metadata.cameraModel << metadata.lensModel << metadata.exposureTime << metadata.fNumber
+			<< metadata.iso << metadata.exposureBias << metadata.focalLength << metadata.focalLength35mmEquivalent;
+		return stream;
+	}
+
+	QDataStream& operator>>(QDataStream& stream, FileMetadata& metadata) {
+		qint32 orientation;
+		stream >> metadata.modified >> metadata.size >> metadata.dimensions >> orientation >> metadata.hasExif
+			>> metadata.captureDate >> metadata.cameraModel >> metadata.lensModel >> metadata.exposureTime >> metadata.fNumber
+			>> metadata.iso >> metadata.exposureBias >> metadata.focalLength >> metadata.focalLength35mmEquivalent;
+		metadata.orientation = orientation;
+		return stream;
+	}
+
+	MetadataIndex::MetadataIndex(std::shared_ptr<ThreadPool> threadPool, int priority, QObject* parent)
+		: QObject(parent),
+		threadPool(threadPool),
+		priority(priority) { }
+
+	MetadataIndex::~MetadataIndex() {
+		stopIndexing();
+		save();
+	}
+
+	///Switches to the index of \p directory; the index of the previous folder is written first.
+	void MetadataIndex::setDirectory(QDir const& directory) {
+		if (hasDirectory && directory == currentDirectory) return;
+		stopIndexing();
+		save();
+		currentDirectory = directory;
+		hasDirectory = true;
+		load();
+	}
+
+	///Queues the files \p names of the current folder for indexing; files with a current entry are skipped when their turn comes.
+	/**
+	 * Files that are queued already or were checked since the folder was set are not queued again, unless
+	 * \p recheck is set because they were (re)written since.
+	 */
+	void MetadataIndex::index(QVector<QString> const& names, bool recheck) {
+		if (!hasDirectory) return;
+		bool added = false;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for (QString const& name : names) {
+				if (queued.contains(name) || (!recheck && checked.contains(name))) continue;
+				queued.insert(name);
+				queue.push_back(name);
+				added = true;
+			}
+		}
+		if (added && !indexing) launchBatch();
+	}
+
+	///Removes the entries of files that are not among \p names, the complete listing of the current folder.
+	void MetadataIndex::prune(QVector<QString> const& names) {
+		if (!hasDirectory) return;
+		QSet<QString> present(names.begin(), names.end());
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto entry = entries.begin(); entry != entries.end();) {
+			if (present.contains(entry.key())) {
+				++entry;
+			} else {
+				entry = entries.erase(entry);
+				modified = true;
+			}
+		}
+	}
+
+	///Returns the entry of \p file in \p metadata if it lies in the current folder, has an entry and has not changed since.
+	bool MetadataIndex::lookup(QFileInfo const& file, FileMetadata& metadata) const {
+		if (!hasDirectory || file.absoluteDir() != currentDirectory) return false;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto entry = entries.constFind(file.fileName());
+			if (entry == entries.constEnd()) return false;
+			metadata = *entry;
+		}
+		QFileInfo info(file.absoluteFilePath());
+		return info.lastModified().toMSecsSinceEpoch() == metadata.modified && info.size() == metadata.size;
+	}
+
+	///Returns the values of \p exif that are kept in the index, which must be ready.
+	FileMetadata MetadataIndex::exifValues(ExifData const& exif) {
+		FileMetadata metadata;
+		if (!exif.hasExif()) return metadata;
+		metadata.hasExif = true;
+		metadata.orientation = exif.orientation();
+		metadata.captureDate = exif.captureDate();
+		metadata.cameraModel = exif.cameraModel();
+		metadata.lensModel = exif.lensModel();
+		metadata.exposureTime = exif.exposureTime();
+		metadata.fNumber = exif.fNumber();
+		metadata.iso = exif.iso();
+		metadata.exposureBias = exif.exposureBias();
+		metadata.focalLength = exif.focalLength();
+		metadata.focalLength35mmEquivalent = exif.focalLength35mmEquivalent();
+		return metadata;
+	}
+
+	///Writes the index of the current folder if it changed since it was read.
+	void MetadataIndex::save() {
+		if (!hasDirectory) return;
+		QHash<QString, FileMetadata> snapshot;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!modified) return;
+			snapshot = entries;
+			modified = false;
+		}
+		QString path = indexPath(currentDirectory);
+		QDir().mkpath(QFileInfo(path).absolutePath());
+		//written to a temporary file that replaces the index at once, so a crash cannot leave a truncated one
+		QSaveFile file(path);
+		if (!file.open(QIODevice::WriteOnly)) return;
+		QDataStream stream(&file);
+		stream.setVersion(QDataStream::Qt_6_0);
+		stream << fileMagic << fileVersion << currentDirectory.absolutePath() << snapshot;
+		file.commit();
+	}
+
+	//=============================================================================== PRIVATE ===============================================================================\\
+
+	///Returns where the index of \p directory is kept, named after a hash of its path.
+	QString MetadataIndex::indexPath(QDir const& directory) {
+		QByteArray hash = QCryptographicHash::hash(directory.absolutePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+		//the application name is not set on the QApplication, so the folder is named like the one of the settings
+		return QDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)).absoluteFilePath(QString("Acute Viewer/metadata/%1.index").arg(QString::fromLatin1(hash)));
+	}
+
+	void MetadataIndex::load() {
+		QHash<QString, FileMetadata> loaded;
+		QFile file(indexPath(currentDirectory));
+		if (file.open(QIODevice::ReadOnly)) {
+			QDataStream stream(&file);
+			stream.setVersion(QDataStream::Qt_6_0);
+			quint32 magic, version;
+			QString path;
+			stream >> magic >> version;
+			if (stream.status() == QDataStream::Ok && magic == fileMagic && version == fileVersion) {
+				stream >> path >> loaded;
+				//a hash collision or a damaged file, start over
+				if (stream.status() != QDataStream::Ok || path != currentDirectory.absolutePath()) loaded.clear();
+			}
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		entries = loaded;
+		queue.clear();
+		queued.clear();
+		checked.clear();
+		modified = false;
+	}
+
+	void MetadataIndex::launchBatch() {
+		indexing = true;
+		cancellation = ThreadPool::makeCancellationToken();
+		ThreadPool::CancellationToken token = cancellation;
+		task = threadPool->enqueue([this, token]() { indexBatch(token); }, priority);
+	}
+
+	///Indexes the next files of the queue, then hands back to the GUI thread to decide whether another batch is needed.
+	void MetadataIndex::indexBatch(ThreadPool::CancellationToken cancellation) {
+		for (int count = 0; count < batchSize; ++count) {
+			if (*cancellation) return;
+			QString name;
+			FileMetadata existing;
+			bool hasEntry;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (queue.empty()) break;
+				name = queue.front();
+				queue.pop_front();
+				queued.remove(name);
+				checked.insert(name);
+				auto entry = entries.constFind(name);
+				hasEntry = entry != entries.constEnd();
+				if (hasEntry) existing = *entry;
+			}
+			QString path = currentDirectory.absoluteFilePath(name);
+			QFileInfo info(path);
+			if (!info.exists()) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (entries.remove(name) > 0) modified = true;
+				continue;
+			}
+			if (hasEntry && info.lastModified().toMSecsSinceEpoch() == existing.modified && info.size() == existing.size) continue;
+			FileMetadata metadata = read(path, info, cancellation);
+			if (*cancellation) return;
+			std::lock_guard<std::mutex> lock(mutex);
+			entries.insert(name, metadata);
+			modified = true;
+		}
+		QMetaObject::invokeMethod(this, [this, cancellation]() {
+			if (!*cancellation) continueIndexing();
+		}, Qt::QueuedConnection);
+	}
+
+	///Queues the next batch if files are left, otherwise writes the index.
+	void MetadataIndex::continueIndexing() {
+		bool done;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			done = queue.empty();
+		}
+		if (done) {
+			indexing = false;
+			task.reset();
+			save();
+		} else {
+			launchBatch();
+		}
+	}
+
+	///Reads the size of the image at \p path from its header and the values the info overlay shows from its EXIF data.
+	FileMetadata MetadataIndex::read(QString const& path, QFileInfo const& info, ThreadPool::CancellationToken cancellation) const {
+		ExifData exif(path, threadPool, priority, true, cancellation);
+		exif.setReadPreviews(false);
+		//still queued, so it is read right here rather than by another worker
+		exif.join();
+		FileMetadata metadata = exifValues(exif);
+		metadata.modified = info.lastModified().toMSecsSinceEpoch();
+		metadata.size = info.size();
+		QSize dimensions = QImageReader(path).size();
+		if (dimensions.isValid()) metadata.dimensions = dimensions;
+		return metadata;
+	}
+
+	void MetadataIndex::stopIndexing() {
+		indexing = false;
+		if (!task) return;
+		*cancellation = true;
+		if (!threadPool->cancel(task)) threadPool->wait(task);
+		task.reset();
+	}
+
+}
\ No newline at end of file
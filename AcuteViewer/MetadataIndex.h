@@ -0,0 +1,90 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <deque>
+
+//Qt
+#include <QtCore>
+#include <QtGui/QImageReader>
+
+#include "ThreadPool.h"
+#include "ExifData.h"
+
+namespace sv {
+
+	///What is known about an image file without decoding it; \c modified and \c size tell whether it is still current.
+	struct FileMetadata {
+		qint64 modified = 0;
+		qint64 size = 0;
+		QSize dimensions;
+		int orientation = -1;
+		bool hasExif = false;
+		QString captureDate;
+		QString cameraModel;
+		QString lensModel;
+		QString exposureTime;
+		QString fNumber;
+		QString iso;
+		QString exposureBias;
+		QString focalLength;
+		QString focalLength35mmEquivalent;
+	};
+
+	QDataStream& operator<<(QDataStream& stream, FileMetadata const& metadata);
+	QDataStream& operator>>(QDataStream& stream, FileMetadata& metadata);
+
+	///Keeps the metadata of the images of a folder in a binary index file in the cache location, so it is available before the images are read.
+	/**
+	 * Missing and outdated entries are filled in by a background indexer that runs at the priority it is
+	 * given, which should be lower than any decode. It works in small batches so decodes that are requested
+	 * in the meantime get the workers first. An entry is only used if the modification time and size of the
+	 * file still match. The index is written when the folder changes, when indexing finishes and on destruction.
+	 */
+	class MetadataIndex : public QObject {
+		Q_OBJECT
+	public:
+		MetadataIndex(std::shared_ptr<ThreadPool> threadPool, int priority, QObject* parent = nullptr);
+		MetadataIndex(MetadataIndex const& other) = delete;
+		MetadataIndex& operator=(MetadataIndex const& other) = delete;
+		~MetadataIndex();
+		void setDirectory(QDir const& directory);
+		void index(QVector<QString> const& names, bool recheck = false);
+		void prune(QVector<QString> const& names);
+		bool lookup(QFileInfo const& file, FileMetadata& metadata) const;
+		static FileMetadata exifValues(ExifData const& exif);
+		void save();
+	private:
+		//functions
+		static QString indexPath(QDir const& directory);
+		void load();
+		void launchBatch();
+		void indexBatch(ThreadPool::CancellationToken cancellation);
+		void continueIndexing();
+		FileMetadata read(QString const& path, QFileInfo const& info, ThreadPool::CancellationToken cancellation) const;
+		void stopIndexing();
+
+		//variables
+		static constexpr quint32 fileMagic = 0x41564d49;
+		static constexpr quint32 fileVersion = 1;
+		//files read per task, after which queued decodes can take over the worker
+		static constexpr int batchSize = 16;
+		std::shared_ptr<ThreadPool> threadPool;
+		int priority;
+		QDir currentDirectory;
+		bool hasDirectory = false;
+		QHash<QString, FileMetadata> entries;
+		std::deque<QString> queue;
+		//the names in the queue and those checked since the folder was set, which are not queued again
+		QSet<QString> queued;
+		QSet<QString> checked;
+		bool modified = false;
+		//guards entries, queue, queued, checked and modified, which the indexer changes from a worker thread
+		mutable std::mutex mutex;
+		//only touched on the GUI thread; a batch is queued or running
+		bool indexing = false;
+		ThreadPool::TaskHandle task;
+		ThreadPool::CancellationToken cancellation;
+	};
+
+}
\ No newline at end of file
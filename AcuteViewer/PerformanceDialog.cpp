@@ -0,0 +1,158 @@
+#include "PerformanceDialog.h"
+
+namespace sv {
+
+	PerformanceDialog::PerformanceDialog(std::shared_ptr<QSettings> settings, QWidget* parent)
+		: settings(settings),
+		QDialog(parent) {
+		setSizePolicy(QSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed));
+		setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);
+
+		setWindowTitle(tr("Performance Options"));
+
+		descriptionLabel = new QLabel(tr("<h3>Image Loading</h3>"
+										 "<p>Decoded images are kept in memory so that going back and forth does not require decoding them again. "
+										 "While you are skipping through a folder, images are decoded ahead of time. The more often you move in the "
+										 "same direction, the further ahead images are decoded, up to the maximum set below. Slow decodes and a small "
+										 "cache reduce the number of images that are decoded ahead of time. With a cache size of 0 only the current and the "
+										 "next image are kept.</p>"
+										 "<p>JPEG images that are displayed at less than half their size can be decoded at a fraction of their resolution, "
+										 "which is considerably faster. The full resolution is decoded as soon as you zoom in further.</p>"
+										 "<p>Images with 16 bit or floating point channels are reduced to 8 bit for display. If they contain linear data, "
+										 "a gamma above 1 brightens them. The gamma applies to images decoded after the change.</p>"
+										 "<p>Images can be converted to the format that is fastest to draw while they are decoded. This makes panning "
+										 "and zooming smoother but takes a third more memory for colour images and four times as much for greyscale images.</p>"
+										 "<p>Images with a higher resolution than the maximum are decoded at a reduced resolution, without ever holding "
+										 "the full resolution in memory. The info overlay marks them as reduced.</p>"), this);
+		descriptionLabel->setWordWrap(true);
+		descriptionLabel->setSizePolicy(QSizePolicy(descriptionLabel->sizePolicy().horizontalPolicy(), QSizePolicy::Minimum));
+		descriptionLabel->setMinimumWidth(400);
+
+		cacheSizeSpinBox = new QSpinBox(this);
+		cacheSizeSpinBox->setMinimum(0);
+		cacheSizeSpinBox->setMaximum(1048576);
+		cacheSizeSpinBox->setSingleStep(256);
+		cacheSizeSpinBox->setSuffix(" MB");
+
+		maximumResolutionSpinBox = new QSpinBox(this);
+		maximumResolutionSpinBox->setMinimum(10);
+		maximumResolutionSpinBox->setMaximum(100000);
+		maximumResolutionSpinBox->setSingleStep(50);
+		maximumResolutionSpinBox->setSuffix(" MP");
+
+		prefetchAheadSpinBox = new QSpinBox(this);
+		prefetchAheadSpinBox->setMinimum(1);
+		prefetchAheadSpinBox->setMaximum(32);
+
+		prefetchBehindSpinBox = new QSpinBox(this);
+		prefetchBehindSpinBox->setMinimum(0);
+		prefetchBehindSpinBox->setMaximum(32);
+
+		reducedDecodingCheckBox = new QCheckBox(tr("&Decode JPEG images at reduced resolution while they are shown downscaled"), this);
+
+		gammaSpinBox = new QDoubleSpinBox(this);
+		gammaSpinBox->setMinimum(0.1);
+		gammaSpinBox->setMaximum(5);
+		gammaSpinBox->setSingleStep(0.1);
+		gammaSpinBox->setDecimals(2);
+
+		paintFormatCheckBox = new QCheckBox(tr("Convert images to the &fastest format for drawing while decoding"), this);
+		QObject::connect(paintFormatCheckBox, SIGNAL(toggled(bool)), this, SLOT(updateMemoryCost()));
+		QObject::connect(cacheSizeSpinBox, SIGNAL(valueChanged(int)), this, SLOT(updateMemoryCost()));
+
+		memoryCostLabel = new QLabel(this);
+		memoryCostLabel->setWordWrap(true);
+
+		formLayout = new QFormLayout();
+		formLayout->setFormAlignment(Qt::AlignCenter);
+		formLayout->addRow(tr("Decoded image &cache size:"), cacheSizeSpinBox);
+		formLayout->addRow(tr("Maximum decoded &resolution:"), maximumResolutionSpinBox);
+		formLayout->addRow(tr("Maximum images decoded &ahead:"), prefetchAheadSpinBox);
+		formLayout->addRow(tr("Maximum images decoded &behind:"), prefetchBehindSpinBox);
+		formLayout->addRow(reducedDecodingCheckBox);
+		formLayout->addRow(tr("&Gamma for high bit depth images:"), gammaSpinBox);
+		formLayout->addRow(paintFormatCheckBox);
+		formLayout->addRow(memoryCostLabel);
+
+		okButton = new QPushButton(tr("&Ok"), this);
+		okButton->setDefault(true);
+		QObject::connect(okButton, SIGNAL(clicked()), this, SLOT(reactToOkButtonClick()));
+
+		cancelButton = new QPushButton(tr("&Cancel"), this);
+		QObject::connect(cancelButton, SIGNAL(clicked()), this, SLOT(reject()));
+
+		buttonLayout = new QHBoxLayout();
+		buttonLayout->addStretch(1);
+		buttonLayout->addWidget(okButton);
+		buttonLayout->addWidget(cancelButton);
+
+		mainLayout = new QVBoxLayout();
+		mainLayout->addWidget(descriptionLabel);
+		mainLayout->addSpacing(10);
+		mainLayout->addLayout(formLayout);
+		mainLayout->addSpacing(10);
+		mainLayout->addLayout(buttonLayout);
+
+		setLayout(mainLayout);
+		layout()->setSizeConstraint(QLayout::SetFixedSize);
+	}
+
+	PerformanceDialog::~PerformanceDialog() {
+		delete mainLayout;
+		delete formLayout;
+		delete buttonLayout;
+		delete descriptionLabel;
+		delete cacheSizeSpinBox;
+		delete maximumResolutionSpinBox;
+		delete prefetchAheadSpinBox;
+		delete prefetchBehindSpinBox;
+		delete reducedDecodingCheckBox;
+		delete gammaSpinBox;
+		delete paintFormatCheckBox;
+		delete memoryCostLabel;
+		delete okButton;
+		delete cancelButton;
+	}
+
+	//============================================================================== PROTECTED ==============================================================================\\
+
+	void PerformanceDialog::showEvent(QShowEvent* event) {
+		cacheSizeSpinBox->setValue(settings->value("imageCacheSize", 2048).toInt());
+		maximumResolutionSpinBox->setValue(settings->value("maximumImageResolution", 250).toInt());
+		prefetchAheadSpinBox->setValue(settings->value("prefetchAhead", 6).toInt());
+		prefetchBehindSpinBox->setValue(settings->value("prefetchBehind", 2).toInt());
+		reducedDecodingCheckBox->setChecked(settings->value("reducedJpegDecoding", true).toBool());
+		gammaSpinBox->setValue(settings->value("highBitDepthGamma", 1.0).toDouble());
+		paintFormatCheckBox->setChecked(settings->value("convertForPainting", false).toBool());
+		updateMemoryCost();
+	}
+
+	//=============================================================================== PRIVATE ===============================================================================\\
+
+	///Returns the size in MB of a decoded image with \p megapixels million pixels and \p channels bytes per pixel.
+	double PerformanceDialog::megapixelImageSize(double megapixels, int channels) {
+		return megapixels * 1000000.0 * channels / 1048576.0;
+	}
+
+	//============================================================================ PRIVATE SLOTS =============================================================================\\
+
+	void PerformanceDialog::reactToOkButtonClick() {
+		settings->setValue("imageCacheSize", cacheSizeSpinBox->value());
+		settings->setValue("maximumImageResolution", maximumResolutionSpinBox->value());
+		settings->setValue("prefetchAhead", prefetchAheadSpinBox->value());
+		settings->setValue("prefetchBehind", prefetchBehindSpinBox->value());
+		settings->setValue("reducedJpegDecoding", reducedDecodingCheckBox->isChecked());
+		settings->setValue("highBitDepthGamma", gammaSpinBox->value());
+		settings->setValue("convertForPainting", paintFormatCheckBox->isChecked());
+		emit(performanceSettingsChanged());
+		accept();
+	}
+
+	void PerformanceDialog::updateMemoryCost() {
+		//a 24 megapixel colour image serves as an example
+		double imageSize = megapixelImageSize(24, paintFormatCheckBox->isChecked() ? 4 : 3);
+		int imageCount = int(cacheSizeSpinBox->value() / imageSize);
+		memoryCostLabel->setText(tr("A decoded 24 megapixel colour image takes %1 MB, the cache holds %2 of them.").arg(imageSize, 0, 'f', 0).arg(imageCount));
+	}
+
+}
\ No newline at end of file
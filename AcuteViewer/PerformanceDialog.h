@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+
+//Qt
+#include <QtCore/QtCore>
+#include <QtGui/QtGui>
+#include <QtWidgets/QtWidgets>
+
+namespace sv {
+
+	class PerformanceDialog : public QDialog {
+		Q_OBJECT
+	public:
+		PerformanceDialog(std::shared_ptr<QSettings> settings, QWidget* parent = 0);
+		~PerformanceDialog();
+	protected:
+		void showEvent(QShowEvent* event);
+	private:
+		//functions
+		static double megapixelImageSize(double megapixels, int channels);
+
+		//variables
+		std::shared_ptr<QSettings> settings;
+		//widgets
+		QVBoxLayout* mainLayout;
+		QFormLayout* formLayout;
+		QHBoxLayout* buttonLayout;
+		QLabel* descriptionLabel;
+		QSpinBox* cacheSizeSpinBox;
+		QSpinBox* maximumResolutionSpinBox;
+		QSpinBox* prefetchAheadSpinBox;
+		QSpinBox* prefetchBehindSpinBox;
+		QCheckBox* reducedDecodingCheckBox;
+		QDoubleSpinBox* gammaSpinBox;
+		QCheckBox* paintFormatCheckBox;
+		QLabel* memoryCostLabel;
+		QPushButton* okButton;
+		QPushButton* cancelButton;
+	private slots:
+		void reactToOkButtonClick();
+		void updateMemoryCost();
+	signals:
+		void performanceSettingsChanged();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "PrefetchPlanner.h"
+
+namespace sv {
+
+	PrefetchPlanner::PrefetchPlanner(int maxAhead, int maxBehind)
+		: maxAhead(std::max(1, maxAhead)),
+		maxBehind(std::max(0, maxBehind)) { }
+
+	void PrefetchPlanner::setMaxAhead(int value) {
+		maxAhead = std::max(1, value);
+	}
+
+	int PrefetchPlanner::getMaxAhead() const {
+		return maxAhead;
+	}
+
+	void PrefetchPlanner::setMaxBehind(int value) {
+		maxBehind = std::max(0, value);
+	}
+
+	int PrefetchPlanner::getMaxBehind() const {
+		return maxBehind;
+	}
+
+	///Sets the amount of memory available for decoded images; as in the image cache 0 means none is kept, so only the next image is decoded ahead.
+	void PrefetchPlanner::setMemoryBudget(size_t bytes) {
+		memoryBudget = bytes;
+	}
+
+	void PrefetchPlanner::setThreadCount(unsigned int value) {
+		threadCount = std::max(1u, value);
+	}
+
+	///Registers a step to the next (\p forward is \c true) or previous image.
+	void PrefetchPlanner::registerStep(bool forward) {
+		if (forward == travelingForward) {
+			++streak;
+		} else {
+			travelingForward = forward;
+			streak = 1;
+		}
+	}
+
+	///Registers that the user jumped to an unrelated image, e.g. by opening a file.
+	void PrefetchPlanner::registerJump() {
+		streak = 0;
+	}
+
+	///Registers a finished decode; may be called from any thread.
+	void PrefetchPlanner::registerDecode(double milliseconds, size_t bytes) {
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+		if (!hasStatistics) {
+			averageDecodeMilliseconds = milliseconds;
+			averageDecodeBytes = double(bytes);
+			hasStatistics = true;
+		} else {
+			averageDecodeMilliseconds += averagingWeight * (milliseconds - averageDecodeMilliseconds);
+			averageDecodeBytes += averagingWeight * (double(bytes) - averageDecodeBytes);
+		}
+	}
+
+	bool PrefetchPlanner::isTravelingForward() const {
+		return travelingForward;
+	}
+
+	///Returns how many images in the direction of travel should be decoded in advance.
+	int PrefetchPlanner::aheadDepth() const {
+		int depth = std::min(maxAhead, 1 + streak);
+		depth = std::min(depth, timeLimitedAhead());
+		//the window (including the current image) has to fit into the cache; one image ahead is always allowed
+		depth = std::min(depth, memoryLimitedWindow() - 1);
+		return std::max(1, depth);
+	}
+
+	///Returns how many images against the direction of travel should be decoded in advance.
+	int PrefetchPlanner::behindDepth() const {
+		//after a jump going back is as likely as not, with every step in the same direction it becomes less likely
+		int depth = 0;
+		if (streak == 0) {
+			depth = maxBehind;
+		} else if (streak == 1) {
+			depth = (maxBehind + 1) / 2;
+		}
+		depth = std::min(depth, memoryLimitedWindow() - 1 - aheadDepth());
+		return std::max(0, depth);
+	}
+
+	//=============================================================================== PRIVATE ===============================================================================\\
+
+	int PrefetchPlanner::memoryLimitedWindow() const {
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+		if (memoryBudget == 0) return 1;
+		if (!hasStatistics || averageDecodeBytes < 1) return maxAhead + maxBehind + 1;
+		//only use half the budget for the window so recently viewed images are not evicted immediately
+		return std::max(1, int((memoryBudget / 2) / averageDecodeBytes));
+	}
+
+	int PrefetchPlanner::timeLimitedAhead() const {
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+		if (!hasStatistics || averageDecodeMilliseconds < 1) return maxAhead;
+		return std::max(1, int(threadCount * aheadTimeHorizon / averageDecodeMilliseconds));
+	}
+
+}
\ No newline at end of file
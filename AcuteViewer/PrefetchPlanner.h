@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mutex>
+#include <algorithm>
+#include <cmath>
+
+namespace sv {
+
+	///Decides how many images around the current one should be decoded in advance.
+	/**
+	 * The window grows in the direction the user keeps travelling and shrinks behind them.
+	 * It is bounded by the configured maximums, by the memory budget of the image cache
+	 * (based on the average size of decoded images) and by the average decode time, so
+	 * that slow decoders do not queue up work that cannot finish before it is needed.
+	 */
+	class PrefetchPlanner {
+	public:
+		PrefetchPlanner(int maxAhead = 6, int maxBehind = 2);
+		void setMaxAhead(int value);
+		int getMaxAhead() const;
+		void setMaxBehind(int value);
+		int getMaxBehind() const;
+		void setMemoryBudget(size_t bytes);
+		void setThreadCount(unsigned int value);
+		void registerStep(bool forward);
+		void registerJump();
+		void registerDecode(double milliseconds, size_t bytes);
+		bool isTravelingForward() const;
+		int aheadDepth() const;
+		int behindDepth() const;
+	private:
+		//functions
+		int memoryLimitedWindow() const;
+		int timeLimitedAhead() const;
+
+		//variables
+		int maxAhead;
+		int maxBehind;
+		size_t memoryBudget = 0;
+		unsigned int threadCount = 1;
+		bool travelingForward = true;
+		int streak = 0;
+		//exponential moving averages of the decodes so far, updated from the worker threads
+		mutable std::mutex statisticsMutex;
+		double averageDecodeMilliseconds = 0;
+		double averageDecodeBytes = 0;
+		bool hasStatistics = false;
+		//how many milliseconds of decoding may be queued up ahead per worker thread
+		static constexpr double aheadTimeHorizon = 2000;
+		static constexpr double averagingWeight = 0.2;
+	};
+
+}
\ No newline at end of file
@@ -1,36 +1,36 @@
-#pragma once
-
-#include <iostream>
-#include <memory>
-
-//Qt
-#include <QtCore/QtCore>
-#include <QtGui/QtGui>
-#include <QtWidgets/QtWidgets>
-
-namespace sv {
-
-	class SlideshowDialog : public QDialog {
-		Q_OBJECT
-	public:
-		SlideshowDialog(std::shared_ptr<QSettings> settings, QWidget* parent = 0);
-		~SlideshowDialog();
-	protected:
-
-	private:
-		//functions
-
-		//variables
-		std::shared_ptr<QSettings> settings;
-		//widgets
-		QVBoxLayout* mainLayout;
-		QFormLayout* formLayout;
-		QHBoxLayout* buttonLayout;
-		QDoubleSpinBox* timeSpinBox;
-		QCheckBox* loopCheckbox;
-		QPushButton* okButton;
-		QPushButton* cancelButton;
-	private slots:
-		void reactToOkButtonClick();
-	};
-}
+#pragma once
+
+#include <iostream>
+#include <memory>
+
+//Qt
+#include <QtCore/QtCore>
+#include <QtGui/QtGui>
+#include <QtWidgets/QtWidgets>
+
+namespace sv {
+
+	class SlideshowDialog : public QDialog {
+		Q_OBJECT
+	public:
+		SlideshowDialog(std::shared_ptr<QSettings> settings, QWidget* parent = 0);
+		~SlideshowDialog();
+	protected:
+
+	private:
+		//functions
+
+		//variables
+		std::shared_ptr<QSettings> settings;
+		//widgets
+		QVBoxLayout* mainLayout;
+		QFormLayout* formLayout;
+		QHBoxLayout* buttonLayout;
+		QDoubleSpinBox* timeSpinBox;
+		QCheckBox* loopCheckbox;
+		QPushButton* okButton;
+		QPushButton* cancelButton;
+	private slots:
+		void reactToOkButtonClick();
+	};
+}
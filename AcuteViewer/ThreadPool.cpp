@@ -0,0 +1,185 @@
+#include "ThreadPool.h"
+
+namespace sv {
+
+	ThreadPool::Task::Task(std::function<void()> function, int priority, unsigned long long sequenceNumber)
+		: function(std::move(function)),
+		taskPriority(priority),
+		sequenceNumber(sequenceNumber) { }
+
+	ThreadPool::Task::State ThreadPool::Task::state() const {
+		return taskState;
+	}
+
+	int ThreadPool::Task::priority() const {
+		return taskPriority;
+	}
+
+	//============================================================================= THREAD POOL =============================================================================\\
+
+	thread_local ThreadPool const* ThreadPool::currentPool = nullptr;
+
+	///Returns how many threads a parallel region (OpenMP) started on the calling thread should use.
+	/**
+	 * On a worker the hardware threads are divided among the workers of its pool, since they may all run
+	 * such a region at the same time; other threads get all of them.
+	 */
+	int ThreadPool::parallelThreadCount() {
+		int hardwareThreads = int(std::max(1u, std::thread::hardware_concurrency()));
+		if (currentPool == nullptr) return hardwareThreads;
+		return std::max(1, hardwareThreads / int(currentPool->threadCount()));
+	}
+
+	///Creates a pool with \p threadCount workers; 0 means one worker per hardware thread (but at least two).
+	ThreadPool::ThreadPool(unsigned int threadCount) {
+		if (threadCount == 0) threadCount = std::max(2u, std::thread::hardware_concurrency());
+		workers.reserve(threadCount);
+		for (unsigned int i = 0; i < threadCount; ++i) {
+			workers.emplace_back(&ThreadPool::workerLoop, this);
+		}
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+			for (TaskHandle const& task : queue) {
+				task->taskState = Task::State::Cancelled;
+				task->function = nullptr;
+				task->finished.notify_all();
+			}
+			queue.clear();
+		}
+		taskAvailable.notify_all();
+		for (std::thread& worker : workers) {
+			if (worker.joinable()) worker.join();
+		}
+	}
+
+	///Adds \p function to the queue; tasks with a lower \p priority value are executed first.
+	ThreadPool::TaskHandle ThreadPool::enqueue(std::function<void()> function, int priority) {
+		std::unique_lock<std::mutex> lock(mutex);
+		TaskHandle task(new Task(std::move(function), priority, nextSequenceNumber++));
+		if (stopping) {
+			task->taskState = Task::State::Cancelled;
+			return task;
+		}
+		queue.push_back(task);
+		lock.unlock();
+		taskAvailable.notify_one();
+		return task;
+	}
+
+	///Changes the priority of \p task; returns \c false if the task has already been started.
+	bool ThreadPool::setPriority(TaskHandle const& task, int priority) {
+		if (!task) return false;
+		std::lock_guard<std::mutex> lock(mutex);
+		if (task->taskState != Task::State::Queued) return false;
+		task->taskPriority = priority;
+		return true;
+	}
+
+	///Removes \p task from the queue; returns \c false if it has already been started.
+	bool ThreadPool::cancel(TaskHandle const& task) {
+		if (!task) return false;
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!takeFromQueue(task)) return false;
+		task->taskState = Task::State::Cancelled;
+		//release the captured state right away, the handle might be kept around for a while
+		task->function = nullptr;
+		task->finished.notify_all();
+		return true;
+	}
+
+	///Cancels all tasks that have not been started yet.
+	void ThreadPool::cancelAll() {
+		std::lock_guard<std::mutex> lock(mutex);
+		for (TaskHandle const& task : queue) {
+			task->taskState = Task::State::Cancelled;
+			task->function = nullptr;
+			task->finished.notify_all();
+		}
+		queue.clear();
+	}
+
+	///Blocks until \p task is finished; if it is still queued it is executed in the calling thread.
+	void ThreadPool::wait(TaskHandle const& task) {
+		if (!task) return;
+		std::unique_lock<std::mutex> lock(mutex);
+		if (takeFromQueue(task)) {
+			run(task, lock);
+			return;
+		}
+		task->finished.wait(lock, [&task]() {
+			return task->taskState == Task::State::Finished || task->taskState == Task::State::Cancelled;
+		});
+	}
+
+	ThreadPool::CancellationToken ThreadPool::makeCancellationToken() {
+		return CancellationToken(new std::atomic<bool>(false));
+	}
+
+	bool ThreadPool::isQueued(TaskHandle const& task) const {
+		return task && task->taskState == Task::State::Queued;
+	}
+
+	bool ThreadPool::isDone(TaskHandle const& task) const {
+		return !task || task->taskState == Task::State::Finished || task->taskState == Task::State::Cancelled;
+	}
+
+	unsigned int ThreadPool::threadCount() const {
+		return static_cast<unsigned int>(workers.size());
+	}
+
+	size_t ThreadPool::queuedTaskCount() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return queue.size();
+	}
+
+	//=============================================================================== PRIVATE ===============================================================================\\
+
+	void ThreadPool::workerLoop() {
+		currentPool = this;
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			taskAvailable.wait(lock, [this]() { return stopping || !queue.empty(); });
+			if (stopping) return;
+			//pick the task with the lowest priority value, the oldest one among equals
+			std::vector<TaskHandle>::iterator next = queue.begin();
+			for (std::vector<TaskHandle>::iterator it = queue.begin() + 1; it < queue.end(); ++it) {
+				if ((*it)->taskPriority < (*next)->taskPriority
+					|| ((*it)->taskPriority == (*next)->taskPriority && (*it)->sequenceNumber < (*next)->sequenceNumber)) {
+					next = it;
+				}
+			}
+			TaskHandle task = *next;
+			queue.erase(next);
+			run(task, lock);
+		}
+	}
+
+	//must be called with the mutex locked
+	bool ThreadPool::takeFromQueue(TaskHandle const& task) {
+		std::vector<TaskHandle>::iterator it = std::find(queue.begin(), queue.end(), task);
+		if (it == queue.end()) return false;
+		queue.erase(it);
+		return true;
+	}
+
+	//must be called with the mutex locked and the task already removed from the queue, returns with the mutex locked
+	void ThreadPool::run(TaskHandle const& task, std::unique_lock<std::mutex>& lock) {
+		task->taskState = Task::State::Running;
+		std::function<void()> function = std::move(task->function);
+		task->function = nullptr;
+		lock.unlock();
+		try {
+			if (function) function();
+		} catch (...) { }
+		//destroy the captured state outside of the lock, it may own objects with expensive destructors
+		function = nullptr;
+		lock.lock();
+		task->taskState = Task::State::Finished;
+		task->finished.notify_all();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+namespace sv {
+
+	///A fixed-size pool of worker threads that executes tasks in the order of their priority.
+	/**
+	 * Tasks with a lower priority value are executed first, tasks with equal priority in the order
+	 * they were enqueued. As long as a task has not been picked up by a worker it can be
+	 * reprioritised or cancelled. Waiting for a task that is still queued executes it in the
+	 * calling thread, so tasks may wait for other tasks of the same pool without deadlocking.
+	 */
+	class ThreadPool {
+	public:
+		class Task {
+		public:
+			enum class State { Queued, Running, Finished, Cancelled };
+			State state() const;
+			int priority() const;
+		private:
+			friend class ThreadPool;
+			Task(std::function<void()> function, int priority, unsigned long long sequenceNumber);
+
+			std::function<void()> function;
+			std::atomic<int> taskPriority;
+			unsigned long long sequenceNumber;
+			std::atomic<State> taskState{ State::Queued };
+			std::condition_variable finished;
+		};
+		using TaskHandle = std::shared_ptr<Task>;
+		//flag through which the owner of a running task can ask it to stop at its next checkpoint
+		using CancellationToken = std::shared_ptr<std::atomic<bool>>;
+		static CancellationToken makeCancellationToken();
+		static int parallelThreadCount();
+
+		ThreadPool(unsigned int threadCount = 0);
+		ThreadPool(ThreadPool const& other) = delete;
+		ThreadPool& operator=(ThreadPool const& other) = delete;
+		~ThreadPool();
+		TaskHandle enqueue(std::function<void()> function, int priority = 0);
+		bool setPriority(TaskHandle const& task, int priority);
+		bool cancel(TaskHandle const& task);
+		void cancelAll();
+		void wait(TaskHandle const& task);
+		bool isQueued(TaskHandle const& task) const;
+		bool isDone(TaskHandle const& task) const;
+		unsigned int threadCount() const;
+		size_t queuedTaskCount() const;
+	private:
+		//functions
+		void workerLoop();
+		bool takeFromQueue(TaskHandle const& task);
+		void run(TaskHandle const& task, std::unique_lock<std::mutex>& lock);
+
+		//variables
+		//the pool the calling thread is a worker of, null on other threads
+		static thread_local ThreadPool const* currentPool;
+		std::vector<std::thread> workers;
+		//the queue is small (a handful of prefetches), so a linear search for the next task is cheaper than keeping a heap ordered when priorities change
+		std::vector<TaskHandle> queue;
+		mutable std::mutex mutex;
+		std::condition_variable taskAvailable;
+		unsigned long long nextSequenceNumber = 0;
+		bool stopping = false;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "TiffTileSource.h"
+
+//OpenCV
+#include <opencv2/imgproc.hpp>
+
+//libtiff
+#ifdef AV_LIBTIFF
+#include <tiffio.h>
+#endif
+
+namespace sv {
+
+	///Opens the TIFF file at \p path; returns \c nullptr if it cannot be read or its full resolution is not stored in tiles.
+	std::shared_ptr<TiffTileSource> TiffTileSource::open(QString const& path) {
+#ifdef AV_LIBTIFF
+		TIFF* tiff = static_cast<TIFF*>(openFile(path));
+		if (tiff == nullptr) return nullptr;
+		std::shared_ptr<TiffTileSource> source(new TiffTileSource());
+		source->tiff = tiff;
+		int directory = 0;
+		do {
+			uint32_t width = 0, height = 0, tileWidth = 0, tileHeight = 0;
+			TIFFGetField(tiff, TIFFTAG_IMAGEWIDTH, &width);
+			TIFFGetField(tiff, TIFFTAG_IMAGELENGTH, &height);
+			bool tiled = TIFFIsTiled(tiff) && TIFFGetField(tiff, TIFFTAG_TILEWIDTH, &tileWidth) && TIFFGetField(tiff, TIFFTAG_TILELENGTH, &tileHeight);
+			if (directory == 0 && !tiled) return nullptr;
+			if (tiled && width > 0 && height > 0 && tileWidth > 0 && tileHeight > 0) {
+				Level level{ directory, QSize(int(width), int(height)), QSize(int(tileWidth), int(tileHeight)) };
+				//label and macro images of slide scans are tiled as well but show something else
+				bool sameAspectRatio = source->levels.empty() || std::abs(double(width) / height - double(source->levels[0].size.width()) / source->levels[0].size.height()) < 0.01 * double(width) / height;
+				if (sameAspectRatio) source->levels.push_back(level);
+			}
+			++directory;
+		} while (TIFFReadDirectory(tiff));
+		std::sort(source->levels.begin(), source->levels.end(), [](Level const& a, Level const& b) { return a.size.width() > b.size.width(); });
+		return source;
+#else
+		return nullptr;
+#endif
+	}
+
+	///Returns the size of the first image in the TIFF file at \p path as stored in its header; invalid if it cannot be read.
+	QSize TiffTileSource::imageSize(QString const& path) {
+#ifdef AV_LIBTIFF
+		std::unique_ptr<TIFF, void(*)(TIFF*)> tiff(static_cast<TIFF*>(openFile(path)), TIFFClose);
+		if (!tiff) return QSize();
+		uint32_t width = 0, height = 0;
+		TIFFGetField(tiff.get(), TIFFTAG_IMAGEWIDTH, &width);
+		TIFFGetField(tiff.get(), TIFFTAG_IMAGELENGTH, &height);
+		if (width == 0 || height == 0 || width > uint32_t(std::numeric_limits<int>::max()) || height > uint32_t(std::numeric_limits<int>::max())) return QSize();
+		return QSize(int(width), int(height));
+#else
+		return QSize();
+#endif
+	}
+
+	///Reads a TIFF file that is stored in strips at 1/\p factor of its resolution as premultiplied BGRA; returns an empty mat on failure.
+	/**
+	 * Each strip is averaged into blocks of \p factor x \p factor pixels right after it is read,
+	 * so besides the result only one strip and one row of sums are held in memory.
+	 */
+	cv::Mat TiffTileSource::readStripsReduced(QString const& path, int factor, ThreadPool::CancellationToken cancellation) {
+#ifdef AV_LIBTIFF
+		std::unique_ptr<TIFF, void(*)(TIFF*)> tiff(static_cast<TIFF*>(openFile(path)), TIFFClose);
+		if (!tiff || TIFFIsTiled(tiff.get()) || factor < 1) return cv::Mat();
+		uint32_t width = 0, height = 0, rowsPerStrip = 0;
+		TIFFGetField(tiff.get(), TIFFTAG_IMAGEWIDTH, &width);
+		TIFFGetField(tiff.get(), TIFFTAG_IMAGELENGTH, &height);
+		TIFFGetFieldDefaulted(tiff.get(), TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+		if (width == 0 || height == 0) return cv::Mat();
+		rowsPerStrip = std::min(std::max(rowsPerStrip, uint32_t(1)), height);
+		//some files store everything in a single strip, reading that would defeat the purpose
+		if (size_t(width) * rowsPerStrip * 4 > maximumStripBytes) return cv::Mat();
+		int resultWidth = int((width + factor - 1) / factor);
+		int resultHeight = int((height + factor - 1) / factor);
+		cv::Mat result(resultHeight, resultWidth, CV_8UC4);
+		std::vector<uint32_t> strip(size_t(width) * rowsPerStrip);
+		std::vector<uint32_t> sums(size_t(resultWidth) * 4, 0);
+		for (uint32_t stripStart = 0; stripStart < height; stripStart += rowsPerStrip) {
+			if (cancellation && *cancellation) return cv::Mat();
+			//converts any photometric interpretation and bit depth to premultiplied 8 bit RGBA
+			if (!TIFFReadRGBAStrip(tiff.get(), stripStart, strip.data())) return cv::Mat();
+			uint32_t rows = std::min(rowsPerStrip, height - stripStart);
+			for (uint32_t rowInStrip = 0; rowInStrip < rows; ++rowInStrip) {
+				//the strip starts with its bottom row
+				uint32_t const* source = strip.data() + size_t(rows - 1 - rowInStrip) * width;
+				for (uint32_t x = 0; x < width; ++x) {
+					uint32_t* sum = sums.data() + size_t(x / factor) * 4;
+					sum[0] += TIFFGetB(source[x]);
+					sum[1] += TIFFGetG(source[x]);
+					sum[2] += TIFFGetR(source[x]);
+					sum[3] += TIFFGetA(source[x]);
+				}
+				uint32_t row = stripStart + rowInStrip;
+				if ((row + 1) % factor != 0 && row + 1 != height) continue;
+				//the block row is complete, write out the averages
+				uint32_t blockRows = row % factor + 1;
+				uchar* destination = result.ptr<uchar>(int(row / factor));
+				for (int column = 0; column < resultWidth; ++column) {
+					uint32_t count = blockRows * std::min(uint32_t(factor), width - uint32_t(column) * factor);
+					for (int channel = 0; channel < 4; ++channel) {
+						destination[column * 4 + channel] = uchar((sums[column * 4 + channel] + count / 2) / count);
+					}
+				}
+				std::fill(sums.begin(), sums.end(), 0);
+			}
+		}
+		return result;
+#else
+		return cv::Mat();
+#endif
+	}
+
+	///Opens the TIFF file at \p path for reading, returns a TIFF* or \c nullptr.
+	void* TiffTileSource::openFile(QString const& path) {
+#ifdef AV_LIBTIFF
+		static std::once_flag silenceLibtiff;
+		std::call_once(silenceLibtiff, []() {
+			//files with unknown tags are common, the warnings would only clutter the console
+			TIFFSetWarningHandler(nullptr);
+			TIFFSetErrorHandler(nullptr);
+		});
+#ifdef Q_OS_WIN
+		return TIFFOpenW(reinterpret_cast<wchar_t const*>(path.utf16()), "r");
+#else
+		return TIFFOpen(QFile::encodeName(path).constData(), "r");
+#endif
+#else
+		return nullptr;
+#endif
+	}
+
+	TiffTileSource::~TiffTileSource() {
+#ifdef AV_LIBTIFF
+		if (tiff) TIFFClose(static_cast<TIFF*>(tiff));
+#endif
+	}
+
+	int TiffTileSource::levelCount() const {
+		return int(levels.size());
+	}
+
+	QSize TiffTileSource::levelSize(int level) const {
+		return levels[level].size;
+	}
+
+	QSize TiffTileSource::tileSize(int level) const {
+		return levels[level].tileSize;
+	}
+
+	QImage TiffTileSource::readTile(int level, int column, int row) {
+#ifdef AV_LIBTIFF
+		if (level < 0 || level >= int(levels.size())) return QImage();
+		Level const& info = levels[level];
+		QRect area = QRect(QPoint(column * info.tileSize.width(), row * info.tileSize.height()), info.tileSize).intersected(QRect(QPoint(0, 0), info.size));
+		if (area.isEmpty()) return QImage();
+		std::vector<uint32_t> raster(size_t(info.tileSize.width()) * info.tileSize.height());
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			TIFF* handle = static_cast<TIFF*>(tiff);
+			if (TIFFCurrentDirectory(handle) != info.directory && !TIFFSetDirectory(handle, info.directory)) return QImage();
+			//converts any photometric interpretation and bit depth to premultiplied 8 bit RGBA
+			if (!TIFFReadRGBATile(handle, area.x(), area.y(), raster.data())) return QImage();
+		}
+		QImage tile(area.size(), QImage::Format_ARGB32_Premultiplied);
+		for (int y = 0; y < area.height(); ++y) {
+			//the raster starts at the bottom left corner of the tile
+			uint32_t const* source = raster.data() + size_t(info.tileSize.height() - 1 - y) * info.tileSize.width();
+			QRgb* destination = reinterpret_cast<QRgb*>(tile.scanLine(y));
+			for (int x = 0; x < area.width(); ++x) {
+				destination[x] = qRgba(TIFFGetR(source[x]), TIFFGetG(source[x]), TIFFGetB(source[x]), TIFFGetA(source[x]));
+			}
+		}
+		return tile;
+#else
+		return QImage();
+#endif
+	}
+
+	///Assembles the image from the smallest level, downscaled to at most \p maxDimension pixels on the long side, as premultiplied BGRA.
+	/**
+	 * The level is read tile by tile, so even without a pyramid the full resolution is never held
+	 * in memory. Returns an empty mat if a tile cannot be read or \p cancellation is set.
+	 */
+	cv::Mat TiffTileSource::overview(int maxDimension, ThreadPool::CancellationToken cancellation) {
+		if (levels.empty()) return cv::Mat();
+		int level = int(levels.size()) - 1;
+		Level const& info = levels[level];
+		double scale = std::min(1.0, double(maxDimension) / double(std::max(info.size.width(), info.size.height())));
+		cv::Mat result(std::max(1, int(std::lround(info.size.height() * scale))), std::max(1, int(std::lround(info.size.width() * scale))), CV_8UC4);
+		int columns = (info.size.width() + info.tileSize.width() - 1) / info.tileSize.width();
+		int rows = (info.size.height() + info.tileSize.height() - 1) / info.tileSize.height();
+		for (int row = 0; row < rows; ++row) {
+			for (int column = 0; column < columns; ++column) {
+				if (cancellation && *cancellation) return cv::Mat();
+				QImage tile = readTile(level, column, row);
+				if (tile.isNull()) return cv::Mat();
+				cv::Mat tileMat(tile.height(), tile.width(), CV_8UC4, tile.bits(), tile.bytesPerLine());
+				//the borders are rounded the same way for neighbouring tiles, so they fit together without gaps
+				int left = int(std::lround(column * info.tileSize.width() * scale));
+				int top = int(std::lround(row * info.tileSize.height() * scale));
+				int right = std::min(result.cols, int(std::lround((column * info.tileSize.width() + tile.width()) * scale)));
+				int bottom = std::min(result.rows, int(std::lround((row * info.tileSize.height() + tile.height()) * scale)));
+				if (right <= left || bottom <= top) continue;
+				cv::Mat destination = result(cv::Rect(left, top, right - left, bottom - top));
+				if (destination.size() == tileMat.size()) {
+					tileMat.copyTo(destination);
+				} else {
+					cv::resize(tileMat, destination, destination.size(), 0, 0, cv::INTER_AREA);
+				}
+			}
+		}
+		return result;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+//Qt
+#include <QtCore/QtCore>
+#include <QtGui/QtGui>
+
+//OpenCV
+#include <opencv2/core.hpp>
+
+#include "TileSource.h"
+#include "ThreadPool.h"
+
+namespace sv {
+
+	///Reads tiled TIFF files, including pyramidal ones, tile by tile so they can be viewed without decoding them as a whole.
+	/**
+	 * Every tiled directory of the file whose aspect ratio matches the first one is a resolution level.
+	 * This is only available if Acute Viewer was built with libtiff (\c AV_LIBTIFF), otherwise \c open()
+	 * always fails. libtiff handles are not thread safe, so reading tiles is serialised.
+	 */
+	class TiffTileSource : public hb::TileSource {
+	public:
+		static std::shared_ptr<TiffTileSource> open(QString const& path);
+		static QSize imageSize(QString const& path);
+		TiffTileSource(TiffTileSource const& other) = delete;
+		TiffTileSource& operator=(TiffTileSource const& other) = delete;
+		~TiffTileSource();
+		int levelCount() const override;
+		QSize levelSize(int level) const override;
+		QSize tileSize(int level) const override;
+		QImage readTile(int level, int column, int row) override;
+		cv::Mat overview(int maxDimension, ThreadPool::CancellationToken cancellation = nullptr);
+		static cv::Mat readStripsReduced(QString const& path, int factor, ThreadPool::CancellationToken cancellation = nullptr);
+	private:
+		TiffTileSource() = default;
+		static void* openFile(QString const& path);
+
+		static constexpr size_t maximumStripBytes = 256 * 1024 * 1024;
+
+		struct Level {
+			int directory;
+			QSize size;
+			QSize tileSize;
+		};
+		//a TIFF*, kept opaque so that users of this class do not need the libtiff headers
+		void* tiff = nullptr;
+		std::vector<Level> levels;
+		std::mutex mutex;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+//Qt
+#include <QtCore/QtCore>
+#include <QtGui/QtGui>
+
+namespace hb {
+
+	///Supplies the pixels of an image that is too large to be held in memory as a whole, tile by tile.
+	/**
+	 * The image may be available at several resolution levels, level 0 being the full resolution
+	 * and every further level a smaller version. Each level is divided into tiles of \c tileSize(),
+	 * tiles at the right and bottom border may be smaller. \c readTile() is called from worker threads
+	 * and must be thread safe.
+	 */
+	class TileSource {
+	public:
+		virtual ~TileSource() = default;
+		virtual int levelCount() const = 0;
+		virtual QSize levelSize(int level) const = 0;
+		virtual QSize tileSize(int level) const = 0;
+		///Returns the tile in \p column and \p row of \p level as \c QImage::Format_ARGB32_Premultiplied, a null image if it cannot be read.
+		virtual QImage readTile(int level, int column, int row) = 0;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "ViewWorkerPool.h"
+
+namespace sv {
+
+	ViewWorkerPool::ViewWorkerPool(std::shared_ptr<ThreadPool> pool, int tilePriority, int pyramidPriority)
+		: pool(pool),
+		tilePriority(tilePriority),
+		pyramidPriority(pyramidPriority) { }
+
+	ViewWorkerPool::TaskHandle ViewWorkerPool::enqueue(std::function<void()> function, Work kind) {
+		if (kind == Work::Resize) return std::make_shared<Task>(Task{ &resizePool, resizePool.enqueue(std::move(function)) });
+		int priority = kind == Work::Tile ? tilePriority : pyramidPriority;
+		return std::make_shared<Task>(Task{ pool.get(), pool->enqueue(std::move(function), priority) });
+	}
+
+	bool ViewWorkerPool::cancel(TaskHandle const& task) {
+		if (!task) return false;
+		Task const& handle = *std::static_pointer_cast<Task>(task);
+		return handle.pool->cancel(handle.task);
+	}
+
+	bool ViewWorkerPool::isDone(TaskHandle const& task) const {
+		if (!task) return true;
+		Task const& handle = *std::static_pointer_cast<Task>(task);
+		return handle.pool->isDone(handle.task);
+	}
+
+	void ViewWorkerPool::wait(TaskHandle const& task) {
+		if (!task) return;
+		Task const& handle = *std::static_pointer_cast<Task>(task);
+		handle.pool->wait(handle.task);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+
+#include "WorkerPool.h"
+#include "ThreadPool.h"
+
+namespace sv {
+
+	///Runs the work of an \c hb::ImageView on the application's \c ThreadPool, with resizes on a worker of their own.
+	/**
+	 * Tiles and pyramid levels are enqueued on the shared pool with the priorities given, so they rank
+	 * among the decodes. Resizes are interactive and run on a dedicated worker instead, a zoom never
+	 * waits until the workers of the shared pool are free.
+	 */
+	class ViewWorkerPool : public hb::WorkerPool {
+	public:
+		ViewWorkerPool(std::shared_ptr<ThreadPool> pool, int tilePriority, int pyramidPriority);
+		TaskHandle enqueue(std::function<void()> function, Work kind) override;
+		bool cancel(TaskHandle const& task) override;
+		bool isDone(TaskHandle const& task) const override;
+		void wait(TaskHandle const& task) override;
+	private:
+		struct Task {
+			ThreadPool* pool;
+			ThreadPool::TaskHandle task;
+		};
+		std::shared_ptr<ThreadPool> pool;
+		//the view abandons a resize when it requests the next one, so one worker is enough
+		ThreadPool resizePool{ 1 };
+		int tilePriority;
+		int pyramidPriority;
+	};
+
+}
\ No newline at end of file
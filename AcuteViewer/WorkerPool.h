@@ -0,0 +1,29 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+namespace hb {
+
+	///Runs the background work of an \c ImageView on worker threads.
+	/**
+	 * The view only states what kind of work a task is; on which threads and with which priority it
+	 * runs is up to the implementation, so it can be scheduled together with the rest of the application.
+	 * Resizes are requested while the user zooms or resizes the window and should not wait behind
+	 * long-running work. A null \c TaskHandle counts as done.
+	 */
+	class WorkerPool {
+	public:
+		enum class Work { Resize, Tile, Pyramid };
+		//identifies an enqueued task, what it points to is up to the implementation
+		using TaskHandle = std::shared_ptr<void>;
+		virtual ~WorkerPool() = default;
+		virtual TaskHandle enqueue(std::function<void()> function, Work kind) = 0;
+		///Removes \p task from the queue if it has not been started yet; returns whether it did.
+		virtual bool cancel(TaskHandle const& task) = 0;
+		virtual bool isDone(TaskHandle const& task) const = 0;
+		///Blocks until \p task has finished or was cancelled.
+		virtual void wait(TaskHandle const& task) = 0;
+	};
+
+}
\ No newline at end of file
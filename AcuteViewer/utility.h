@@ -1,29 +1,61 @@
-#pragma once
-
-#include <vector>
-#include <fstream>
-#include <memory>
-
-//Qt
-#include <QtCore>
-#include <QtGui>
-#include <QtWidgets>
-
-//Windows
-#ifdef Q_OS_WIN
-#include <Windows.h>
-#endif
-
-namespace utility {
-
-	std::shared_ptr<std::vector<char>> readFileIntoBuffer(QString const& path);
-
-	bool isCharCompatible(QString const& string);
-
-	bool moveFileToRecycleBin(QString const & filepath);
-
-	bool moveFile(QString const & oldPath, QString const & newPath, bool silent = false, QWidget * parent = 0);
-
-	bool copyFile(QString const & oldPath, QString const & newPath, bool silent = false, QWidget * parent = 0);
-
+#pragma once
+
+#include <vector>
+#include <fstream>
+#include <memory>
+
+//Qt
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+//Windows
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#endif
+
+namespace utility {
+
+	///Read-only contents of a file; large files are memory-mapped, small ones are read into memory.
+	/**
+	 * The mapping stays valid for the lifetime of the object, so share it through a \c std::shared_ptr
+	 * (see \c mapFile()) to keep the bytes alive for as long as any consumer reads from them.
+	 * If the file cannot be mapped its contents are read instead, if it cannot be read it is empty.
+	 * Files that were modified recently are read as well, since they may still be written (e.g. by a
+	 * tethered camera or an editor saving in place). On Unix, truncating a mapped file raises SIGBUS
+	 * on access; this check makes that unlikely but cannot rule it out for older files.
+	 */
+	class FileBuffer {
+	public:
+		FileBuffer(QString const& path);
+		FileBuffer(FileBuffer const& other) = delete;
+		FileBuffer& operator=(FileBuffer const& other) = delete;
+		~FileBuffer();
+		char const* data() const;
+		size_t size() const;
+		bool empty() const;
+		bool isMapped() const;
+	private:
+		//below this size reading is cheaper than setting up a mapping
+		static constexpr qint64 minimumMappingSize = 256 * 1024;
+		//files modified within this many seconds may still be written to
+		static constexpr qint64 settlingTime = 30;
+		QFile file;
+		uchar* mapping = nullptr;
+		qint64 mappingSize = 0;
+		std::shared_ptr<std::vector<char>> contents;
+	};
+
+	std::shared_ptr<FileBuffer> mapFile(QString const& path);
+
+	std::shared_ptr<std::vector<char>> readFileIntoBuffer(QString const& path);
+
+	bool isCharCompatible(QString const& string);
+
+	bool moveFileToRecycleBin(QString const & filepath);
+
+	bool moveFile(QString const & oldPath, QString const & newPath, bool silent = false, QWidget * parent = 0);
+
+	bool copyFile(QString const & oldPath, QString const & newPath, bool silent = false, QWidget * parent = 0);
+
 }
\ No newline at end of file